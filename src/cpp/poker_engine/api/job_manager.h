@@ -6,6 +6,7 @@
 #include <mutex>
 #include <chrono>
 #include "engine/equity_result.h"
+#include "engine/preflop_matrix.h"
 #include <memory>
 
 enum class JobStatus {
@@ -24,6 +25,7 @@ struct JobState {
     std::string error;
     std::unordered_map<std::string, EquityResult> results;
     std::unordered_map<std::string, double> current_results;
+    std::shared_ptr<const poker_engine::PreflopMatrix> matrix;  // preflop_matrix jobs only
 
     mutable std::mutex lock;
 
@@ -36,10 +38,12 @@ struct JobState {
         status = JobStatus::RUNNING;
     }
 
-    void complete(const std::unordered_map<std::string, EquityResult>& res) {
+    void complete(const std::unordered_map<std::string, EquityResult>& res,
+                  std::shared_ptr<const poker_engine::PreflopMatrix> mat = nullptr) {
         std::lock_guard<std::mutex> guard(lock);
         status = JobStatus::COMPLETED;
         results = res;
+        matrix = std::move(mat);
         completed_at = std::chrono::system_clock::now();
         progress = 1.0;
     }
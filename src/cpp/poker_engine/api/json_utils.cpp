@@ -1,43 +1,52 @@
 #include "json_utils.h"
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
 
-bool parse_create_job_request(
-    const std::string& json_str,
-    std::unordered_map<std::string, std::vector<Card>>& range_spec,
-    std::vector<Card>& board,
-    int& num_opponents,
-    int& num_simulations,
-    std::string& mode,
-    std::string& algorithm,
-    std::vector<std::string>& optimizations,
-    int& num_workers) {
-
+bool parse_create_job_request(const std::string& json_str,
+                              poker_engine::JobRequest& request) {
     using namespace rapidjson;
 
+    auto& range_spec = request.range_spec;
+    auto& board = request.board;
+
     Document doc;
     if (doc.Parse(json_str.c_str()).HasParseError()) {
         return false;
     }
 
-    // Parse range_spec (required)
-    if (!doc.HasMember("range_spec") || !doc["range_spec"].IsObject()) {
+    // Hands: range_spec, range notation ("TT+, AKs, KQo:0.5"), or both
+    const bool has_spec = doc.HasMember("range_spec");
+    const bool has_notation = doc.HasMember("range") && !doc["range"].IsNull();
+    if ((!has_spec && !has_notation) || (has_spec && !doc["range_spec"].IsObject())) {
         return false;
     }
+    if (has_notation) {
+        if (!doc["range"].IsString()) {
+            return false;
+        }
+        try {
+            request.range = parse_range_notation(doc["range"].GetString());
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
 
-    const Value& range_obj = doc["range_spec"];
-    for (auto it = range_obj.MemberBegin(); it != range_obj.MemberEnd(); ++it) {
-        std::string hand_name = it->name.GetString();
-        const Value& cards_arr = it->value;
+    if (has_spec) {
+        const Value& range_obj = doc["range_spec"];
+        for (auto it = range_obj.MemberBegin(); it != range_obj.MemberEnd(); ++it) {
+            std::string hand_name = it->name.GetString();
+            const Value& cards_arr = it->value;
 
-        std::vector<Card> cards;
-        for (SizeType i = 0; i < cards_arr.Size(); ++i) {
-            const Value& card_obj = cards_arr[i];
-            uint8_t rank = card_obj["rank"].GetInt();
-            uint8_t suit = card_obj["suit"].GetInt();
-            cards.push_back(Card(rank, suit));
+            std::vector<Card> cards;
+            for (SizeType i = 0; i < cards_arr.Size(); ++i) {
+                const Value& card_obj = cards_arr[i];
+                uint8_t rank = card_obj["rank"].GetInt();
+                uint8_t suit = card_obj["suit"].GetInt();
+                cards.push_back(Card(rank, suit));
+            }
+            range_spec[hand_name] = cards;
         }
-        range_spec[hand_name] = cards;
     }
 
     // Parse board (optional, default empty)
@@ -52,24 +61,124 @@ bool parse_create_job_request(
     }
 
     // Parse other fields
-    num_opponents = doc.HasMember("num_opponents") ? doc["num_opponents"].GetInt() : 1;
-    num_simulations = doc.HasMember("num_simulations") ? doc["num_simulations"].GetInt() : 100000;
-    mode = doc.HasMember("mode") ? doc["mode"].GetString() : "cpp_naive";
-    algorithm = doc.HasMember("algorithm") ? doc["algorithm"].GetString() : "naive";
+    request.num_opponents = doc.HasMember("num_opponents") ? doc["num_opponents"].GetInt() : 1;
+    request.num_simulations = doc.HasMember("num_simulations") ? doc["num_simulations"].GetInt() : 100000;
+    request.mode = doc.HasMember("mode") ? doc["mode"].GetString() : "cpp_naive";
+    request.algorithm = doc.HasMember("algorithm") ? doc["algorithm"].GetString() : "naive";
+    request.schedule = doc.HasMember("schedule") && doc["schedule"].IsString()
+                           ? doc["schedule"].GetString()
+                           : "uniform";
     
     // Parse optimizations (optional array)
     if (doc.HasMember("optimizations") && doc["optimizations"].IsArray()) {
         const Value& opts_arr = doc["optimizations"];
         for (SizeType i = 0; i < opts_arr.Size(); ++i) {
-            optimizations.push_back(opts_arr[i].GetString());
+            request.optimizations.push_back(opts_arr[i].GetString());
+        }
+    }
+
+    request.num_workers = doc.HasMember("num_workers") ? doc["num_workers"].GetInt() : 0;
+
+    // Parse seed (optional unsigned 64-bit; absent means a fresh random seed)
+    if (doc.HasMember("seed") && !doc["seed"].IsNull()) {
+        if (!doc["seed"].IsUint64()) {
+            return false;
+        }
+        request.seed = doc["seed"].GetUint64();
+    }
+
+    // Precision target (optional): a standard error, or the half-width of a
+    // 95% normal interval, which is 1.96 standard errors
+    if (doc.HasMember("target_std_error") && !doc["target_std_error"].IsNull()) {
+        if (!doc["target_std_error"].IsNumber() || doc["target_std_error"].GetDouble() <= 0) {
+            return false;
         }
+        request.target_std_error = doc["target_std_error"].GetDouble();
+    } else if (doc.HasMember("target_ci_half_width") && !doc["target_ci_half_width"].IsNull()) {
+        if (!doc["target_ci_half_width"].IsNumber() || doc["target_ci_half_width"].GetDouble() <= 0) {
+            return false;
+        }
+        request.target_std_error = doc["target_ci_half_width"].GetDouble() / 1.96;
     }
 
-    num_workers = doc.HasMember("num_workers") ? doc["num_workers"].GetInt() : 0;
+    // Opponent ranges (optional): per seat, range notation or a list of
+    // {"cards": [card, card], "weight": w}; weight defaults to 1
+    if (doc.HasMember("opponent_ranges") && !doc["opponent_ranges"].IsNull()) {
+        const Value& ranges_arr = doc["opponent_ranges"];
+        if (!ranges_arr.IsArray()) {
+            return false;
+        }
+        for (SizeType r = 0; r < ranges_arr.Size(); ++r) {
+            const Value& combos_arr = ranges_arr[r];
+            if (combos_arr.IsString()) {
+                try {
+                    request.opponent_ranges.push_back(
+                        poker_engine::weighted_range(parse_range_notation(combos_arr.GetString())));
+                } catch (const std::invalid_argument&) {
+                    return false;
+                }
+                continue;
+            }
+            if (!combos_arr.IsArray()) {
+                return false;
+            }
+            poker_engine::WeightedRange& range = request.opponent_ranges.emplace_back();
+            for (SizeType i = 0; i < combos_arr.Size(); ++i) {
+                const Value& combo_obj = combos_arr[i];
+                if (!combo_obj.IsObject() || !combo_obj.HasMember("cards") ||
+                    !combo_obj["cards"].IsArray() || combo_obj["cards"].Size() != 2) {
+                    return false;
+                }
+                poker_engine::WeightedCombo combo;
+                for (SizeType c = 0; c < 2; ++c) {
+                    const Value& card_obj = combo_obj["cards"][c];
+                    if (!card_obj.IsObject() || !card_obj.HasMember("rank") || !card_obj.HasMember("suit") ||
+                        !card_obj["rank"].IsInt() || !card_obj["suit"].IsInt()) {
+                        return false;
+                    }
+                    combo.cards[c] = Card(card_obj["rank"].GetInt(), card_obj["suit"].GetInt());
+                }
+                if (combo_obj.HasMember("weight")) {
+                    if (!combo_obj["weight"].IsNumber()) {
+                        return false;
+                    }
+                    combo.weight = combo_obj["weight"].GetDouble();
+                }
+                range.push_back(combo);
+            }
+        }
+    }
 
     return true;
 }
 
+bool parse_create_job_request(
+    const std::string& json_str,
+    std::unordered_map<std::string, std::vector<Card>>& range_spec,
+    std::vector<Card>& board,
+    int& num_opponents,
+    int& num_simulations,
+    std::string& mode,
+    std::string& algorithm,
+    std::vector<std::string>& optimizations,
+    int& num_workers) {
+
+    poker_engine::JobRequest request;
+    if (!parse_create_job_request(json_str, request)) {
+        return false;
+    }
+
+    range_spec = std::move(request.range_spec);
+    board = std::move(request.board);
+    num_opponents = request.num_opponents;
+    num_simulations = request.num_simulations;
+    mode = std::move(request.mode);
+    algorithm = std::move(request.algorithm);
+    optimizations = std::move(request.optimizations);
+    num_workers = request.num_workers;
+    return true;
+}
+
 std::string serialize_create_job_response(
     const std::string& job_id,
     const std::string& status,
@@ -139,8 +248,46 @@ std::string serialize_job_status_response(const JobState& state) {
     return buffer.GetString();
 }
 
-std::string serialize_health_response() {
-    return R"({"status":"healthy","version":"0.1.0"})";
+std::string serialize_preflop_matrix(const poker_engine::PreflopMatrix& matrix) {
+    using namespace rapidjson;
+    constexpr int kSize = poker_engine::PreflopMatrix::kSize;
+
+    Document doc;
+    doc.SetObject();
+    auto& allocator = doc.GetAllocator();
+
+    Value classes(kArrayType);
+    for (int hand_class = 0; hand_class < kSize; ++hand_class) {
+        classes.PushBack(Value(hand_class_name(hand_class).c_str(), allocator), allocator);
+    }
+    doc.AddMember("classes", classes, allocator);
+    doc.AddMember("boards", static_cast<uint64_t>(matrix.boards), allocator);
+
+    auto rows = [&](auto rate) {
+        Value out(kArrayType);
+        for (int hero = 0; hero < kSize; ++hero) {
+            Value row(kArrayType);
+            for (int villain = 0; villain < kSize; ++villain) {
+                row.PushBack(static_cast<double>(rate(hero, villain)), allocator);
+            }
+            out.PushBack(row, allocator);
+        }
+        return out;
+    };
+    doc.AddMember("equity", rows([&](int h, int v) { return matrix.equity(h, v); }), allocator);
+    doc.AddMember("win", rows([&](int h, int v) { return matrix.win_rate(h, v); }), allocator);
+    doc.AddMember("tie", rows([&](int h, int v) { return matrix.tie_rate(h, v); }), allocator);
+
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    return buffer.GetString();
+}
+
+std::string serialize_health_response(bool ready) {
+    return ready ? R"({"status":"healthy","version":"0.1.0"})"
+                 : R"({"status":"warming","version":"0.1.0"})";
 }
 
 std::string serialize_error_response(const std::string& message) {
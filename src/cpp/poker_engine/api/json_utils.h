@@ -17,6 +17,12 @@ namespace poker_engine {
     struct JobRequest;
 }
 
+// Parse CreateJobRequest into a JobRequest
+// Matches: src/python/api/models.py (plus the optional "seed" field)
+bool parse_create_job_request(const std::string& json,
+                              poker_engine::JobRequest& request);
+
+// Field-by-field variant (ignores "seed")
 bool parse_create_job_request(const std::string& json, 
                               std::unordered_map<std::string, std::vector<Card>>& range_spec,
                               
@@ -40,8 +46,13 @@ std::string serialize_create_job_response(
 // Matches: src/python/api/models.py:45-51
 std::string serialize_job_status_response(const JobState& state);
 
-// Serialize health check response
-std::string serialize_health_response();
+// Serialize a preflop matrix: {"classes": [169 names], "boards": n,
+// "equity": rows, "win": rows, "tie": rows}, rows in `classes` order
+std::string serialize_preflop_matrix(const poker_engine::PreflopMatrix& matrix);
+
+// Serialize health check response: "healthy" once the evaluators' lookup
+// tables are warm, "warming" before
+std::string serialize_health_response(bool ready = true);
 
 // Serialize error response
 std::string serialize_error_response(const std::string& message);
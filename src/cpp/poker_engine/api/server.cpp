@@ -66,15 +66,8 @@ void APIServer::setup_routes() {
         std::cout << "Received POST /api/jobs" << std::endl;
 
         // Parse request
-        std::unordered_map<std::string, std::vector<Card>> range_spec;
-        std::vector<Card> board;
-        int num_opponents, num_simulations, num_workers;
-        std::string mode, algorithm;
-        std::vector<std::string> optimizations;
-
-        if (!parse_create_job_request(req.body, range_spec, board,
-                                      num_opponents, num_simulations, mode, 
-                                      algorithm, optimizations, num_workers)) {
+        poker_engine::JobRequest job_req;
+        if (!parse_create_job_request(req.body, job_req)) {
             std::cerr << "Failed to parse request body" << std::endl;
             res.status = 400;
             res.set_content(serialize_error_response("Invalid request body"), "application/json");
@@ -84,7 +77,7 @@ void APIServer::setup_routes() {
 
         // Generate job ID
         std::string job_id = generate_uuid();
-        std::cout << "Created job: " << job_id << " mode=" << mode << " algorithm=" << algorithm << std::endl;
+        std::cout << "Created job: " << job_id << " mode=" << job_req.mode << " algorithm=" << job_req.algorithm << std::endl;
 
         auto job_state = job_manager_.create_job(job_id);
 
@@ -106,18 +99,9 @@ void APIServer::setup_routes() {
             telemetry_url << ws_protocol << "://" << ws_host << ":" << ws_port << "/telemetry/" << job_id;
         }
 
-        // Create job request
-        poker_engine::JobRequest job_req;
-        job_req.range_spec = range_spec;
-        job_req.board = board;
-        job_req.num_opponents = num_opponents;
-        job_req.num_simulations = num_simulations;
-        job_req.mode = mode;
-        job_req.algorithm = algorithm;
-        job_req.optimizations = optimizations;
-        job_req.num_workers = num_workers;
-
-        // Execute job in background thread
+        // The job's driver gets a thread of its own and only its (hand,
+        // chunk) tasks go to the shared pool, so a waiting job never picks
+        // up another whole job
         std::thread([this, job_id, job_req]() {
             this->execute_job(job_id, job_req);
         }).detach();
@@ -152,10 +136,39 @@ void APIServer::setup_routes() {
         add_cors_headers(req, res);
     });
 
-    // GET /health - Health check
-    server_->Get("/health", [](const httplib::Request& req, httplib::Response& res) {
+    // GET /api/jobs/{job_id}/matrix - A preflop_matrix job's 169x169 matrix:
+    // the binary layout of PreflopMatrix::to_binary, or JSON with ?format=json
+    server_->Get(R"(/api/jobs/([^/]+)/matrix)", [this](const httplib::Request& req, httplib::Response& res) {
+        std::string job_id = req.matches[1];
+
+        auto job_state = job_manager_.get_job(job_id);
+        std::shared_ptr<const poker_engine::PreflopMatrix> matrix;
+        if (job_state) {
+            std::lock_guard<std::mutex> guard(job_state->lock);
+            matrix = job_state->matrix;
+        }
+        if (!matrix) {
+            res.status = 404;
+            res.set_content(serialize_error_response(job_state ? "Job has no preflop matrix" : "Job not found"),
+                            "application/json");
+            add_cors_headers(req, res);
+            return;
+        }
+
         res.status = 200;
-        res.set_content(serialize_health_response(), "application/json");
+        if (req.get_param_value("format") == "json") {
+            res.set_content(serialize_preflop_matrix(*matrix), "application/json");
+        } else {
+            res.set_content(matrix->to_binary(), "application/octet-stream");
+        }
+        add_cors_headers(req, res);
+    });
+
+    // GET /health - Health check; 503 until the evaluators are warm
+    server_->Get("/health", [](const httplib::Request& req, httplib::Response& res) {
+        const bool ready = poker_engine::EvaluatorRegistry::ready();
+        res.status = ready ? 200 : 503;
+        res.set_content(serialize_health_response(ready), "application/json");
         add_cors_headers(req, res);
     });
 }
@@ -215,7 +228,7 @@ void APIServer::execute_job(const std::string& job_id, const poker_engine::JobRe
         // Run calculation
         auto results = engine.calculate_range_equity(request);
 
-        job_state->complete(results);
+        job_state->complete(results, engine.preflop_matrix());
 
     } catch (const std::exception& e) {
         job_state->fail(e.what());
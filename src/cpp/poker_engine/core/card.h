@@ -9,8 +9,8 @@ struct Card {
     uint8_t rank;  // 2-14 (J=11, Q=12, K=13, A=14)
     uint8_t suit;  // 0-3 (hearts, diamonds, clubs, spades)
 
-    Card() : rank(0), suit(0) {}
-    Card(uint8_t r, uint8_t s) : rank(r), suit(s) {}
+    constexpr Card() : rank(0), suit(0) {}
+    constexpr Card(uint8_t r, uint8_t s) : rank(r), suit(s) {}
 
     bool operator==(const Card& other) const {
         return rank == other.rank && suit == other.suit;
@@ -20,6 +20,16 @@ struct Card {
     std::string to_string() const;
 };
 
+// Compact card id 0-51: (rank - 2) * 4 + suit. This is the TwoPlusTwo
+// table's card numbering minus one, and the bit index used by Deck's mask.
+constexpr uint8_t card_id(const Card& c) {
+    return static_cast<uint8_t>((c.rank - 2) * 4 + c.suit);
+}
+
+constexpr Card card_from_id(uint8_t id) {
+    return Card(static_cast<uint8_t>(id / 4 + 2), static_cast<uint8_t>(id % 4));
+}
+
 // Hash function for std::unordered_set
 struct CardHash {
     std::size_t operator()(const Card& c) const {
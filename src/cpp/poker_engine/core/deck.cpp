@@ -1,69 +1,120 @@
 #include "core/deck.h"
-#include <algorithm>
 #include <stdexcept>
 
-Deck::Deck() : rng_(std::random_device{}()) {
-    // Create full 52-card deck (matches Python: range(2, 15) x range(4))
-    for (uint8_t rank = 2; rank <= 14; ++rank) {
-        for (uint8_t suit = 0; suit < 4; ++suit) {
-            cards_.insert(Card(rank, suit));
-        }
-    }
+namespace {
+
+constexpr uint64_t kFullDeckMask = (uint64_t{1} << 52) - 1;
+
+}  // namespace
+
+Deck::Deck() : Deck(random_seed()) {}
+
+Deck::Deck(uint64_t seed, uint64_t stream) : rng_(seed, stream) {
+    // Full 52-card template (matches Python: range(2, 15) x range(4))
+    set_dead_cards({});
 }
 
-Deck::Deck(uint32_t seed) : rng_(seed) {
-    for (uint8_t rank = 2; rank <= 14; ++rank) {
-        for (uint8_t suit = 0; suit < 4; ++suit) {
-            cards_.insert(Card(rank, suit));
+uint32_t Deck::random_index(uint32_t n) {
+    // The high half of x * n is uniform in [0, n) once the few low values
+    // that would bias it are rejected
+    uint64_t m = static_cast<uint64_t>(rng_()) * n;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < n) {
+        uint32_t threshold = static_cast<uint32_t>(-n) % n;
+        while (low < threshold) {
+            m = static_cast<uint64_t>(rng_()) * n;
+            low = static_cast<uint32_t>(m);
         }
     }
+    return static_cast<uint32_t>(m >> 32);
+}
+
+void Deck::remove_id(uint8_t id) {
+    uint8_t slot = position_[id];
+    uint8_t last = cards_[size_ - 1];
+    cards_[slot] = last;
+    position_[last] = slot;
+    --size_;
+    mask_ &= ~(uint64_t{1} << id);
 }
 
 void Deck::remove(const Card& card) {
-    cards_.erase(card);
+    if (contains(card)) {
+        remove_id(card_id(card));
+    }
 }
 
 void Deck::reset() {
-    cards_.clear();
-    for (uint8_t r = 2; r <= 14; ++r) {
-        for (uint8_t s = 0; s < 4; ++s) {
-            cards_.insert(Card(r, s));
+    cards_ = template_cards_;
+    position_ = template_position_;
+    mask_ = template_mask_;
+    size_ = template_size_;
+}
+
+void Deck::set_dead_cards(const std::vector<Card>& dead) {
+    uint64_t dead_mask = 0;
+    for (const auto& card : dead) {
+        if (card.rank >= 2 && card.rank <= 14 && card.suit < 4) {
+            dead_mask |= uint64_t{1} << card_id(card);
+        }
+    }
+
+    template_mask_ = kFullDeckMask & ~dead_mask;
+    template_size_ = 0;
+    template_position_.fill(0);
+    for (uint8_t id = 0; id < kDeckSize; ++id) {
+        if (template_mask_ & (uint64_t{1} << id)) {
+            template_position_[id] = static_cast<uint8_t>(template_size_);
+            template_cards_[template_size_++] = id;
         }
     }
+    reset();
 }
 
 bool Deck::contains(const Card& card) const {
-    return cards_.find(card) != cards_.end();
+    if (card.rank < 2 || card.rank > 14 || card.suit > 3) {
+        return false;
+    }
+    return (mask_ >> card_id(card)) & 1;
 }
 
 Card Deck::draw_random() {
-    if (cards_.empty()) {
+    if (size_ == 0) {
         throw std::runtime_error("Cannot draw from empty deck");
     }
 
-    // Convert set to vector and select random element
-    std::vector<Card> card_vec(cards_.begin(), cards_.end());
-    std::uniform_int_distribution<size_t> dist(0, card_vec.size() - 1);
-    Card drawn = card_vec[dist(rng_)];
-    cards_.erase(drawn);
-    return drawn;
+    uint8_t id = cards_[random_index(static_cast<uint32_t>(size_))];
+    remove_id(id);
+    return card_from_id(id);
 }
 
-std::vector<Card> Deck::sample(size_t n) {
-    if (n > cards_.size()) {
+void Deck::sample_into(Card* out, size_t n) {
+    if (n > size_) {
         throw std::runtime_error("Cannot sample more cards than available");
     }
 
-    std::vector<Card> result;
-    result.reserve(n);
-
     for (size_t i = 0; i < n; ++i) {
-        result.push_back(draw_random());
+        uint8_t id = cards_[random_index(static_cast<uint32_t>(size_))];
+        remove_id(id);
+        out[i] = card_from_id(id);
     }
+}
 
+std::vector<Card> Deck::sample(size_t n) {
+    if (n > size_) {
+        throw std::runtime_error("Cannot sample more cards than available");
+    }
+
+    std::vector<Card> result(n);
+    sample_into(result.data(), n);
     return result;
 }
 
 std::vector<Card> Deck::all_cards() const {
-    return std::vector<Card>(cards_.begin(), cards_.end());
+    std::vector<Card> result;
+    result.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) {
+        result.push_back(card_from_id(cards_[i]));
+    }
+    return result;
 }
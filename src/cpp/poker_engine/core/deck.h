@@ -2,27 +2,56 @@
 #define CORE_DECK_H
 
 #include "card.h"
-#include <unordered_set>
+#include "philox.h"
+#include <array>
+#include <cstdint>
 #include <vector>
-#include <random>
 
-// Deck represented as unordered_set for O(1) removal
-// Matches Python's set-based deck approach
+// Deck as a fixed array of card ids plus a 64-bit membership mask.
+// Removal swaps the card with the last live slot, so remove/draw are O(1).
+// reset() restores a template (the full deck, or the deck minus the cards
+// passed to set_dead_cards), which lets the engine strip hole cards and the
+// board once per hand instead of once per simulation.
 class Deck {
 private:
-    std::unordered_set<Card, CardHash> cards_;
-    std::mt19937 rng_;
+    static constexpr size_t kDeckSize = 52;
+
+    // Live card ids live in cards_[0, size_); position_[id] is the slot
+    // holding id, valid only while the id's bit is set in mask_
+    std::array<uint8_t, kDeckSize> cards_;
+    std::array<uint8_t, kDeckSize> position_;
+    uint64_t mask_;
+    size_t size_;
+
+    // State restored by reset()
+    std::array<uint8_t, kDeckSize> template_cards_;
+    std::array<uint8_t, kDeckSize> template_position_;
+    uint64_t template_mask_;
+    size_t template_size_;
+
+    Philox4x32 rng_;
+
+    // Uniform index in [0, n) (Lemire's multiply-shift with rejection)
+    uint32_t random_index(uint32_t n);
+    void remove_id(uint8_t id);
 
 public:
     Deck();
-    explicit Deck(uint32_t seed);
+    explicit Deck(uint64_t seed, uint64_t stream = 0);
+
+    // Restart the random stream; the cards in the deck are unchanged
+    void reseed(uint64_t seed, uint64_t stream = 0) { rng_.reseed(seed, stream); }
 
-    // Remove card from deck (Python: deck.discard())
+    // Remove card from deck (Python: deck.discard()); no-op if absent
     void remove(const Card& card);
 
-    // Reset deck to full 52 cards
+    // Reset deck to the template: all 52 cards unless set_dead_cards was used
     void reset();
 
+    // Make `dead` permanently absent: the template drops them and the deck
+    // resets to it. An empty list restores the full 52-card template.
+    void set_dead_cards(const std::vector<Card>& dead);
+
     // Check if deck contains card
     bool contains(const Card& card) const;
 
@@ -32,8 +61,19 @@ public:
     // Sample N cards without replacement (Python: random.sample(list(deck), n))
     std::vector<Card> sample(size_t n);
 
+    // Allocation-free sample: writes n cards to out
+    void sample_into(Card* out, size_t n);
+
+    // Draws from the deck's own stream for callers that pick cards some
+    // other way (weighted ranges), so a seeded chunk stays one stream
+    uint32_t uniform_index(uint32_t n) { return random_index(n); }
+    uint32_t random_bits() { return rng_(); }
+
     // Remaining card count
-    size_t size() const { return cards_.size(); }
+    size_t size() const { return size_; }
+
+    // Bit card_id(c) is set for every card still in the deck
+    uint64_t mask() const { return mask_; }
 
     // For testing: get all cards
     std::vector<Card> all_cards() const;
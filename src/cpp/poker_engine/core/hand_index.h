@@ -0,0 +1,99 @@
+#ifndef CORE_HAND_INDEX_H
+#define CORE_HAND_INDEX_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "core/card.h"
+
+// Dense indices for two-card hands, so per-hand statistics can live in flat
+// arrays and names are only built when results leave the engine.
+//
+// Hand class (169): the usual 13x13 grid with aces first. Row and column are
+// 14 - rank; pairs sit on the diagonal, suited hands above it (row = high
+// rank) and offsuit hands below it (row = low rank). AKs is 1, AKo is 13.
+//
+// Combo (1326): every unordered pair of card ids, c_low < c_high, at
+// c_high * (c_high - 1) / 2 + c_low.
+constexpr int kNumHandClasses = 169;
+constexpr int kNumHandCombos = 1326;
+
+constexpr int hand_class_index(uint8_t high_rank, uint8_t low_rank, bool suited) {
+    const int high = 14 - high_rank;
+    const int low = 14 - low_rank;
+    return suited ? high * 13 + low : low * 13 + high;
+}
+
+constexpr int hand_combo_index(uint8_t id1, uint8_t id2) {
+    const int lo = id1 < id2 ? id1 : id2;
+    const int hi = id1 < id2 ? id2 : id1;
+    return hi * (hi - 1) / 2 + lo;
+}
+
+namespace hand_index_tables {
+
+// (card id, card id) -> hand class, for the simulation loop
+constexpr auto kClassOfIds = [] {
+    std::array<uint8_t, 52 * 52> table{};
+    for (int a = 0; a < 52; ++a) {
+        for (int b = 0; b < 52; ++b) {
+            const Card ca = card_from_id(static_cast<uint8_t>(a));
+            const Card cb = card_from_id(static_cast<uint8_t>(b));
+            const uint8_t high = ca.rank > cb.rank ? ca.rank : cb.rank;
+            const uint8_t low = ca.rank > cb.rank ? cb.rank : ca.rank;
+            table[a * 52 + b] = static_cast<uint8_t>(
+                hand_class_index(high, low, ca.suit == cb.suit && high != low));
+        }
+    }
+    return table;
+}();
+
+// Combo -> its two card ids (low id first)
+constexpr auto kComboCards = [] {
+    std::array<std::array<uint8_t, 2>, kNumHandCombos> table{};
+    for (int hi = 1; hi < 52; ++hi) {
+        for (int lo = 0; lo < hi; ++lo) {
+            table[hand_combo_index(static_cast<uint8_t>(lo), static_cast<uint8_t>(hi))] = {
+                static_cast<uint8_t>(lo), static_cast<uint8_t>(hi)};
+        }
+    }
+    return table;
+}();
+
+// Combo -> hand class
+constexpr auto kClassOfCombo = [] {
+    std::array<uint8_t, kNumHandCombos> table{};
+    for (int c = 0; c < kNumHandCombos; ++c) {
+        table[c] = kClassOfIds[kComboCards[c][0] * 52 + kComboCards[c][1]];
+    }
+    return table;
+}();
+
+}  // namespace hand_index_tables
+
+constexpr int hand_class_of(uint8_t id1, uint8_t id2) {
+    return hand_index_tables::kClassOfIds[id1 * 52 + id2];
+}
+
+constexpr int hand_class_of(const Card& c1, const Card& c2) {
+    return hand_class_of(card_id(c1), card_id(c2));
+}
+
+// "AA", "AKs", "72o": the same names NaiveEvaluator::classify_hole_cards gives
+inline std::string hand_class_name(int hand_class) {
+    static constexpr char kRankChars[] = "AKQJT98765432";
+    const int row = hand_class / 13;
+    const int col = hand_class % 13;
+    std::string name;
+    if (row == col) {
+        name = {kRankChars[row], kRankChars[col]};
+    } else if (row < col) {
+        name = {kRankChars[row], kRankChars[col], 's'};
+    } else {
+        name = {kRankChars[col], kRankChars[row], 'o'};
+    }
+    return name;
+}
+
+#endif  // CORE_HAND_INDEX_H
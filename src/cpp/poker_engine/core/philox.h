@@ -0,0 +1,75 @@
+#ifndef CORE_PHILOX_H
+#define CORE_PHILOX_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3", SC'11). Each 128-bit output block is a pure
+// function of (key, counter), so a 64-bit seed plus a 64-bit stream id name
+// an independent sequence with no state to advance or jump: any worker or
+// process can start any stream directly. State is 44 bytes, versus ~5 KB
+// for std::mt19937.
+class Philox4x32 {
+public:
+    using result_type = uint32_t;
+    using Block = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) {
+        reseed(seed, stream);
+    }
+
+    // Key = seed; counter = (block index, stream). Restarts the stream.
+    void reseed(uint64_t seed, uint64_t stream) {
+        key_ = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+        counter_ = {0, 0, static_cast<uint32_t>(stream),
+                    static_cast<uint32_t>(stream >> 32)};
+        index_ = 4;
+    }
+
+    result_type operator()() {
+        if (index_ == 4) {
+            output_ = block(counter_, key_);
+            // 64-bit block index in the low two counter words
+            if (++counter_[0] == 0) ++counter_[1];
+            index_ = 0;
+        }
+        return output_[index_++];
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    // The bijection itself: ten rounds keyed by a Weyl sequence
+    static constexpr Block block(Block ctr, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * ctr[0];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * ctr[2];
+            ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                   static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                   static_cast<uint32_t>(p0)};
+        }
+        return ctr;
+    }
+
+private:
+    Key key_;
+    Block counter_;
+    Block output_;
+    uint32_t index_;
+};
+
+// 64 bits from std::random_device, for callers that were not given a seed
+inline uint64_t random_seed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+#endif // CORE_PHILOX_H
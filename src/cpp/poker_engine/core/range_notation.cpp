@@ -0,0 +1,181 @@
+#include "core/range_notation.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Combos holding each card id
+const auto kCombosHolding = [] {
+    std::array<ComboSet, 52> table{};
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+        for (uint8_t id : hand_index_tables::kComboCards[combo]) table[id].insert(combo);
+    }
+    return table;
+}();
+
+constexpr std::string_view kSuitChars = "hdcs";  // Card::to_string's order
+
+// 2-14, or 0 if `c` is not a rank character
+uint8_t rank_of(char c) {
+    switch (c) {
+        case 'A': case 'a': return 14;
+        case 'K': case 'k': return 13;
+        case 'Q': case 'q': return 12;
+        case 'J': case 'j': return 11;
+        case 'T': case 't': return 10;
+        default: return (c >= '2' && c <= '9') ? static_cast<uint8_t>(c - '0') : 0;
+    }
+}
+
+// Which combos of a rank pair a class token names
+enum class Suitedness { PAIR, SUITED, OFFSUIT, ANY };
+
+// "AK", "AKs", "AKo" or "AA", high rank first after parsing
+struct HandClass {
+    uint8_t high = 0;
+    uint8_t low = 0;
+    Suitedness kind = Suitedness::ANY;
+};
+
+[[noreturn]] void bad_item(std::string_view item) {
+    throw std::invalid_argument("invalid range item '" + std::string(item) + "'");
+}
+
+bool parse_class(std::string_view text, HandClass& out) {
+    if (text.size() < 2 || text.size() > 3) return false;
+    uint8_t a = rank_of(text[0]);
+    uint8_t b = rank_of(text[1]);
+    if (a == 0 || b == 0) return false;
+    out.high = std::max(a, b);
+    out.low = std::min(a, b);
+    if (a == b) {
+        out.kind = Suitedness::PAIR;
+        return text.size() == 2;
+    }
+    out.kind = Suitedness::ANY;
+    if (text.size() == 3) {
+        if (text[2] == 's' || text[2] == 'S') {
+            out.kind = Suitedness::SUITED;
+        } else if (text[2] == 'o' || text[2] == 'O') {
+            out.kind = Suitedness::OFFSUIT;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Calls fn(combo) for every combo of one rank pair
+template <typename Fn>
+void for_each_combo(uint8_t high, uint8_t low, Suitedness kind, Fn&& fn) {
+    for (uint8_t s1 = 0; s1 < 4; ++s1) {
+        for (uint8_t s2 = 0; s2 < 4; ++s2) {
+            if (kind == Suitedness::PAIR ? s2 <= s1
+                : kind == Suitedness::SUITED ? s1 != s2
+                : kind == Suitedness::OFFSUIT ? s1 == s2
+                : false) {
+                continue;
+            }
+            fn(hand_combo_index(card_id(Card(high, s1)), card_id(Card(low, s2))));
+        }
+    }
+}
+
+// One item without its weight: calls fn(combo) for each combo it names
+template <typename Fn>
+void expand_item(std::string_view token, std::string_view item, Fn&& fn) {
+    // One combo: rank, suit, rank, suit
+    if (token.size() == 4 && kSuitChars.find(token[1]) != std::string_view::npos &&
+        kSuitChars.find(token[3]) != std::string_view::npos) {
+        const uint8_t r1 = rank_of(token[0]);
+        const uint8_t r2 = rank_of(token[2]);
+        const auto s1 = static_cast<uint8_t>(kSuitChars.find(token[1]));
+        const auto s2 = static_cast<uint8_t>(kSuitChars.find(token[3]));
+        if (r1 == 0 || r2 == 0 || (r1 == r2 && s1 == s2)) bad_item(item);
+        fn(hand_combo_index(card_id(Card(r1, s1)), card_id(Card(r2, s2))));
+        return;
+    }
+
+    HandClass first;
+    if (const size_t dash = token.find('-'); dash != std::string_view::npos) {
+        // Span: both ends the same shape, pairs or one high card's kickers
+        HandClass last;
+        if (!parse_class(token.substr(0, dash), first) ||
+            !parse_class(token.substr(dash + 1), last) || first.kind != last.kind) {
+            bad_item(item);
+        }
+        if (first.kind == Suitedness::PAIR) {
+            for (uint8_t r = std::min(first.high, last.high); r <= std::max(first.high, last.high); ++r) {
+                for_each_combo(r, r, Suitedness::PAIR, fn);
+            }
+        } else {
+            if (first.high != last.high) bad_item(item);
+            for (uint8_t r = std::min(first.low, last.low); r <= std::max(first.low, last.low); ++r) {
+                for_each_combo(first.high, r, first.kind, fn);
+            }
+        }
+        return;
+    }
+
+    const bool plus = !token.empty() && token.back() == '+';
+    if (!parse_class(plus ? token.substr(0, token.size() - 1) : token, first)) bad_item(item);
+    if (first.kind == Suitedness::PAIR) {
+        for (uint8_t r = first.high; r <= (plus ? 14 : first.high); ++r) {
+            for_each_combo(r, r, Suitedness::PAIR, fn);
+        }
+    } else {
+        for (uint8_t r = first.low; r <= (plus ? first.high - 1 : first.low); ++r) {
+            for_each_combo(first.high, r, first.kind, fn);
+        }
+    }
+}
+
+}  // namespace
+
+ComboSet ComboSet::holding(uint64_t card_mask) {
+    ComboSet result;
+    for (; card_mask; card_mask &= card_mask - 1) {
+        result |= kCombosHolding[std::countr_zero(card_mask)];
+    }
+    return result;
+}
+
+ComboRange parse_range_notation(std::string_view notation) {
+    ComboRange range;
+    std::string item;
+    size_t begin = 0;
+    while (begin <= notation.size()) {
+        size_t end = notation.find(',', begin);
+        if (end == std::string_view::npos) end = notation.size();
+
+        item.clear();
+        for (char c : notation.substr(begin, end - begin)) {
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') item += c;
+        }
+        begin = end + 1;
+        if (item.empty()) continue;
+
+        std::string_view token = item;
+        double weight = 1.0;
+        if (const size_t colon = token.find(':'); colon != std::string_view::npos) {
+            const char* first = item.data() + colon + 1;
+            const char* last = item.data() + item.size();
+            const auto [ptr, ec] = std::from_chars(first, last, weight);
+            if (ec != std::errc() || ptr != last || first == last || !std::isfinite(weight) ||
+                weight < 0.0) {
+                bad_item(item);
+            }
+            token = token.substr(0, colon);
+        }
+        expand_item(token, item, [&range, weight](int combo) { range.set(combo, weight); });
+    }
+    return range;
+}
+
+std::string combo_name(int combo) {
+    const auto& cards = hand_index_tables::kComboCards[combo];
+    return card_from_id(cards[1]).to_string() + card_from_id(cards[0]).to_string();
+}
@@ -0,0 +1,100 @@
+#ifndef CORE_RANGE_NOTATION_H
+#define CORE_RANGE_NOTATION_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "core/hand_index.h"
+
+// A set of two-card combos as 1326 bits in hand_combo_index order. Set
+// algebra is word by word over 21 words, which compilers vectorize.
+class ComboSet {
+public:
+    static constexpr int kWords = (kNumHandCombos + 63) / 64;
+
+    constexpr void insert(int combo) { words_[combo >> 6] |= uint64_t{1} << (combo & 63); }
+    constexpr void erase(int combo) { words_[combo >> 6] &= ~(uint64_t{1} << (combo & 63)); }
+    constexpr bool contains(int combo) const {
+        return (words_[combo >> 6] >> (combo & 63)) & 1;
+    }
+
+    int count() const {
+        int n = 0;
+        for (uint64_t word : words_) n += std::popcount(word);
+        return n;
+    }
+    bool empty() const { return count() == 0; }
+
+    ComboSet& operator|=(const ComboSet& other) {
+        for (int w = 0; w < kWords; ++w) words_[w] |= other.words_[w];
+        return *this;
+    }
+    ComboSet& operator&=(const ComboSet& other) {
+        for (int w = 0; w < kWords; ++w) words_[w] &= other.words_[w];
+        return *this;
+    }
+    // Set difference
+    ComboSet& operator-=(const ComboSet& other) {
+        for (int w = 0; w < kWords; ++w) words_[w] &= ~other.words_[w];
+        return *this;
+    }
+    friend ComboSet operator|(ComboSet a, const ComboSet& b) { return a |= b; }
+    friend ComboSet operator&(ComboSet a, const ComboSet& b) { return a &= b; }
+    friend ComboSet operator-(ComboSet a, const ComboSet& b) { return a -= b; }
+    bool operator==(const ComboSet& other) const = default;
+
+    // Every combo holding a card whose id bit is set in `card_mask`: the
+    // combos a board or dead cards block
+    static ComboSet holding(uint64_t card_mask);
+
+    // Calls fn(combo) for every combo in the set, in increasing order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (int w = 0; w < kWords; ++w) {
+            for (uint64_t bits = words_[w]; bits; bits &= bits - 1) {
+                fn(w * 64 + std::countr_zero(bits));
+            }
+        }
+    }
+
+private:
+    std::array<uint64_t, kWords> words_{};
+};
+
+// A range compiled from notation: its combos and how often each is held.
+// Weights are only meaningful for combos in the set.
+struct ComboRange {
+    ComboSet combos;
+    std::array<double, kNumHandCombos> weights{};
+
+    // Adds `combo` at `weight`, replacing an earlier weight; 0 removes it
+    void set(int combo, double weight) {
+        weights[combo] = weight;
+        if (weight > 0.0) {
+            combos.insert(combo);
+        } else {
+            combos.erase(combo);
+        }
+    }
+
+    // Drops the combos that share a card with `card_mask` (board, dead cards)
+    void remove_blocked(uint64_t card_mask) { combos -= ComboSet::holding(card_mask); }
+};
+
+// Compiles standard range notation: comma-separated items, each optionally
+// ":weight" (default 1; 0 removes), later items overriding earlier ones.
+//   "AA", "AKs", "AKo", "AK"     a hand class ("AK" is suited and offsuit)
+//   "TT+", "ATs+", "AT+"          pairs up to aces, kickers up to one below
+//   "22-55", "A2s-A5s", "K9o-KJo" pairs, or kickers under one high card
+//   "AhKd"                        one combo (suits h, d, c, s)
+// Whitespace is ignored and ranks may be lower case. Throws
+// std::invalid_argument naming the first item it cannot read.
+ComboRange parse_range_notation(std::string_view notation);
+
+// A combo's name, high card first: "AsKd", "7h2c"
+std::string combo_name(int combo);
+
+#endif  // CORE_RANGE_NOTATION_H
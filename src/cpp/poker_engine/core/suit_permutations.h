@@ -0,0 +1,27 @@
+#ifndef CORE_SUIT_PERMUTATIONS_H
+#define CORE_SUIT_PERMUTATIONS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// Hand values do not depend on suit names, so anything dealt is equivalent
+// to its image under any of the 24 relabellings of the four suits.
+
+// The 24 orders of the four suits: perm[suit] is the suit it becomes
+constexpr auto kSuitPermutations = [] {
+    std::array<std::array<uint8_t, 4>, 24> perms{};
+    std::array<uint8_t, 4> perm = {0, 1, 2, 3};
+    for (auto& out : perms) {
+        out = perm;
+        std::next_permutation(perm.begin(), perm.end());
+    }
+    return perms;
+}();
+
+// Card id `id` with its suit relabelled
+constexpr uint8_t relabel_suit(uint8_t id, const std::array<uint8_t, 4>& suit_map) {
+    return static_cast<uint8_t>((id & ~3) | suit_map[id & 3]);
+}
+
+#endif  // CORE_SUIT_PERMUTATIONS_H
@@ -0,0 +1,68 @@
+#ifndef ENGINE_ALIAS_TABLE_H
+#define ENGINE_ALIAS_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace poker_engine {
+
+/**
+ * @brief Walker's alias method: draws index i with probability
+ * weights[i] / sum in O(1).
+ *
+ * Every column holds one index and an alias. A draw picks a uniform
+ * column and keeps its index with the column's probability (a 32-bit
+ * threshold), or takes its alias. Built with Vose's method, which moves
+ * the excess of the heavy columns into the light ones without sorting.
+ */
+class AliasTable {
+ public:
+  AliasTable() = default;
+
+  // Weights must be non-negative with a positive sum
+  explicit AliasTable(const std::vector<double>& weights)
+      : threshold_(weights.size(), kAlways), alias_(weights.size()) {
+    const size_t n = weights.size();
+    double sum = 0.0;
+    for (double w : weights) sum += w;
+
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> light;
+    std::vector<uint32_t> heavy;
+    for (size_t i = 0; i < n; ++i) {
+      alias_[i] = static_cast<uint32_t>(i);
+      scaled[i] = weights[i] * static_cast<double>(n) / sum;
+      (scaled[i] < 1.0 ? light : heavy).push_back(static_cast<uint32_t>(i));
+    }
+    while (!light.empty() && !heavy.empty()) {
+      const uint32_t small = light.back();
+      const uint32_t large = heavy.back();
+      light.pop_back();
+      threshold_[small] = static_cast<uint64_t>(scaled[small] * 4294967296.0);
+      alias_[small] = large;
+      scaled[large] -= 1.0 - scaled[small];
+      if (scaled[large] < 1.0) {
+        heavy.pop_back();
+        light.push_back(large);
+      }
+    }
+    // Whatever is left is 1 up to rounding and keeps its own index
+  }
+
+  size_t size() const { return threshold_.size(); }
+
+  // `column` uniform in [0, size()), `coin` 32 uniform bits
+  uint32_t sample(uint32_t column, uint32_t coin) const {
+    return coin < threshold_[column] ? column : alias_[column];
+  }
+
+ private:
+  static constexpr uint64_t kAlways = uint64_t{1} << 32;
+
+  std::vector<uint64_t> threshold_;  // keep the column's index if coin < this
+  std::vector<uint32_t> alias_;
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_ALIAS_TABLE_H
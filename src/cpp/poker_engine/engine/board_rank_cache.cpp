@@ -0,0 +1,190 @@
+#include "board_rank_cache.h"
+
+#include <algorithm>
+
+#include "core/suit_permutations.h"
+
+namespace poker_engine {
+
+namespace {
+
+// Completions are filled in this many slices when a pool is given
+constexpr int kFillTasks = 32;
+
+}  // namespace
+
+CanonicalBoard canonicalize_board(const std::array<uint8_t, 5>& board) {
+  CanonicalBoard best;
+  best.mask = ~uint64_t{0};
+  for (const auto& perm : kSuitPermutations) {
+    uint64_t mask = 0;
+    for (uint8_t id : board) mask |= uint64_t{1} << relabel_suit(id, perm);
+    if (mask < best.mask) {
+      best.mask = mask;
+      best.suit_map = perm;
+    }
+  }
+  return best;
+}
+
+BoardRankCache& BoardRankCache::instance() {
+  static BoardRankCache cache(kDefaultCapacity);
+  return cache;
+}
+
+BoardRankCache::BoardRankCache(size_t capacity) : capacity_(std::max<size_t>(1, capacity)) {}
+
+std::shared_ptr<const BoardRanks> BoardRankCache::get(uint8_t evaluator,
+                                                      const std::array<uint8_t, 5>& board,
+                                                      const Fill& fill) {
+  const CanonicalBoard canonical = canonicalize_board(board);
+  const uint64_t key = key_of(evaluator, canonical.mask);
+
+  std::shared_ptr<const BoardRanks> ranks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      ranks = it->second->ranks;
+      hits_++;
+    } else {
+      misses_++;
+    }
+  }
+
+  if (!ranks) {
+    std::array<uint8_t, 5> canonical_board;
+    int n = 0;
+    for (uint8_t id = 0; id < 52; ++id) {
+      if (canonical.mask & (uint64_t{1} << id)) canonical_board[n++] = id;
+    }
+    auto filled = std::make_shared<BoardRanks>();
+    fill(canonical_board, *filled);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      ranks = it->second->ranks;
+    } else {
+      lru_.push_front(Entry{key, filled});
+      index_[key] = lru_.begin();
+      ranks = std::move(filled);
+      while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+      }
+    }
+  }
+
+  if (canonical.suit_map == std::array<uint8_t, 4>{0, 1, 2, 3}) return ranks;
+
+  // Back to the board's own suits: a combo's value is its canonical image's
+  auto relabelled = std::make_shared<BoardRanks>();
+  for (int combo = 0; combo < kNumHandCombos; ++combo) {
+    const auto& cards = hand_index_tables::kComboCards[combo];
+    (*relabelled)[combo] = (*ranks)[hand_combo_index(relabel_suit(cards[0], canonical.suit_map),
+                                                     relabel_suit(cards[1], canonical.suit_map))];
+  }
+  return relabelled;
+}
+
+bool BoardRankCache::contains(uint8_t evaluator, const std::array<uint8_t, 5>& board) const {
+  const uint64_t key = key_of(evaluator, canonicalize_board(board).mask);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.count(key) != 0;
+}
+
+BoardRankCache::Stats BoardRankCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Stats{hits_, misses_, lru_.size()};
+}
+
+void BoardRankCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+int RunoutRanks::count(int known_board) {
+  switch (known_board) {
+    case 5: return 1;
+    case 4: return 48;
+    case 3: return 49 * 48 / 2;
+    default: return 0;
+  }
+}
+
+template <typename Fn>
+void RunoutRanks::for_each_runout(const std::vector<uint8_t>& known_board, Fn&& fn) {
+  std::array<uint8_t, 5> board{};
+  uint64_t dead = 0;
+  for (size_t i = 0; i < known_board.size(); ++i) {
+    board[i] = known_board[i];
+    dead |= uint64_t{1} << known_board[i];
+  }
+  if (known_board.size() == 5) {
+    fn(board, 0);
+  } else if (known_board.size() == 4) {
+    for (uint8_t river = 0; river < 52; ++river) {
+      if (dead & (uint64_t{1} << river)) continue;
+      board[4] = river;
+      fn(board, river);
+    }
+  } else {
+    for (uint8_t hi = 1; hi < 52; ++hi) {
+      if (dead & (uint64_t{1} << hi)) continue;
+      for (uint8_t lo = 0; lo < hi; ++lo) {
+        if (dead & (uint64_t{1} << lo)) continue;
+        board[3] = lo;
+        board[4] = hi;
+        fn(board, hand_combo_index(lo, hi));
+      }
+    }
+  }
+}
+
+int RunoutRanks::missing(const BoardRankCache& cache, uint8_t evaluator,
+                         const std::vector<uint8_t>& known_board) {
+  if (count(static_cast<int>(known_board.size())) == 0) return 0;
+  int result = 0;
+  for_each_runout(known_board, [&](const std::array<uint8_t, 5>& board, int) {
+    if (!cache.contains(evaluator, board)) result++;
+  });
+  return result;
+}
+
+RunoutRanks::RunoutRanks(BoardRankCache& cache, uint8_t evaluator,
+                         const std::vector<uint8_t>& known_board,
+                         const BoardRankCache::Fill& fill, ThreadPool* pool)
+    : known_(static_cast<int>(known_board.size())) {
+  table_.assign(known_ == 5 ? 1 : known_ == 4 ? 52 : kNumHandCombos, nullptr);
+
+  std::vector<std::pair<std::array<uint8_t, 5>, int>> runouts;
+  for_each_runout(known_board, [&](const std::array<uint8_t, 5>& board, int slot) {
+    runouts.emplace_back(board, slot);
+  });
+  vectors_.resize(runouts.size());
+
+  auto fill_range = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) vectors_[i] = cache.get(evaluator, runouts[i].first, fill);
+  };
+  if (pool && runouts.size() > 1) {
+    TaskGroup group(*pool);
+    const size_t step = (runouts.size() + kFillTasks - 1) / kFillTasks;
+    for (size_t begin = 0; begin < runouts.size(); begin += step) {
+      group.run([&fill_range, begin, step, &runouts] {
+        fill_range(begin, std::min(begin + step, runouts.size()));
+      });
+    }
+    group.wait();
+  } else {
+    fill_range(0, runouts.size());
+  }
+
+  for (size_t i = 0; i < runouts.size(); ++i) table_[runouts[i].second] = vectors_[i]->data();
+}
+
+}  // namespace poker_engine
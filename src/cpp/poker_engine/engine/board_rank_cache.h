@@ -0,0 +1,130 @@
+#ifndef ENGINE_BOARD_RANK_CACHE_H
+#define ENGINE_BOARD_RANK_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/hand_index.h"
+#include "thread_pool.h"
+
+namespace poker_engine {
+
+// Every hole-card combo's value on one 5-card board, by hand_combo_index.
+// Combos that share a card with the board hold 0.
+using BoardRanks = std::array<int32_t, kNumHandCombos>;
+
+// A board relabelled by the suit permutation that gives the smallest card
+// mask. Boards that only differ by suits share a canonical form, and hand
+// values do not depend on suit names, so they share one rank vector.
+struct CanonicalBoard {
+  uint64_t mask = 0;                // canonical cards, bit card_id
+  std::array<uint8_t, 4> suit_map;  // actual suit -> canonical suit
+};
+
+CanonicalBoard canonicalize_board(const std::array<uint8_t, 5>& board);
+
+/**
+ * @brief Process-wide LRU cache of per-board rank vectors.
+ *
+ * Keyed by evaluator and suit-canonical board, so every job on a board (or
+ * on any suit relabelling of it) after the first reads its showdowns out of
+ * a table instead of evaluating them. Vectors are handed out as shared
+ * pointers: an evicted vector stays valid for the jobs still holding it.
+ */
+class BoardRankCache {
+ public:
+  // Computes the vector of a (canonical) board on a miss
+  using Fill = std::function<void(const std::array<uint8_t, 5>& board, BoardRanks& ranks)>;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t size = 0;
+  };
+
+  // About 22 MB of vectors: every runout of a few flops
+  static constexpr size_t kDefaultCapacity = 4096;
+
+  // The shared cache, created on first use
+  static BoardRankCache& instance();
+
+  explicit BoardRankCache(size_t capacity);
+
+  BoardRankCache(const BoardRankCache&) = delete;
+  BoardRankCache& operator=(const BoardRankCache&) = delete;
+
+  // `board`'s vector in its own suits. `evaluator` separates the value
+  // scales of different evaluators. On a miss `fill` runs without the lock
+  // held; two threads missing the same board both fill it and one wins.
+  std::shared_ptr<const BoardRanks> get(uint8_t evaluator, const std::array<uint8_t, 5>& board,
+                                        const Fill& fill);
+
+  // Whether get() would hit; does not refresh the entry
+  bool contains(uint8_t evaluator, const std::array<uint8_t, 5>& board) const;
+
+  Stats stats() const;
+  void clear();
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::shared_ptr<const BoardRanks> ranks;
+  };
+
+  static uint64_t key_of(uint8_t evaluator, uint64_t canonical_mask) {
+    return canonical_mask | (static_cast<uint64_t>(evaluator) << 56);
+  }
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  std::list<Entry> lru_;  // most recently used first
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> index_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+/**
+ * @brief A job's rank vectors for every completion of its known board.
+ *
+ * Built once per job from BoardRankCache for a flop (1176 runouts), turn
+ * (48) or river (1); kernels then find a dealt board's vector by the cards
+ * dealt after the known ones, and every showdown on it is one load.
+ */
+class RunoutRanks {
+ public:
+  // Completions of a board of `known_board` cards; 0 unless it is 3 to 5
+  static int count(int known_board);
+
+  // Completions of `known_board` whose vectors are not cached yet
+  static int missing(const BoardRankCache& cache, uint8_t evaluator,
+                     const std::vector<uint8_t>& known_board);
+
+  // Gets every completion's vector, filling misses on `pool` when given
+  RunoutRanks(BoardRankCache& cache, uint8_t evaluator, const std::vector<uint8_t>& known_board,
+              const BoardRankCache::Fill& fill, ThreadPool* pool);
+
+  // Vector of a full board (card ids) that starts with the known board
+  const int32_t* find(const uint8_t* board) const {
+    const int slot = known_ == 5 ? 0 : known_ == 4 ? board[4] : hand_combo_index(board[3], board[4]);
+    return table_[slot];
+  }
+
+ private:
+  // Calls fn(board, slot) for every completion
+  template <typename Fn>
+  static void for_each_runout(const std::vector<uint8_t>& known_board, Fn&& fn);
+
+  int known_;
+  std::vector<std::shared_ptr<const BoardRanks>> vectors_;
+  std::vector<const int32_t*> table_;  // by slot; null where a card repeats
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_BOARD_RANK_CACHE_H
@@ -3,16 +3,407 @@
 #include <algorithm>
 #include <thread>
 #include <mutex>
+#include <array>
+#include <chrono>
+#include <stdexcept>
+#include <climits>
+#include <cmath>
+#include <type_traits>
+#include <utility>
 #include "core/deck.h"
+#include "core/philox.h"
+#include "core/suit_permutations.h"
+#include "alias_table.h"
+#include "runout_enumerator.h"
 
 namespace poker_engine {
 
-EquityEngine::EquityEngine(const std::string& mode, const std::string& job_id)
-    : mode_(mode),
-      update_frequency_(1000),
-      last_update_count_(0) {
-    
-    simulations_processed_.store(0);
+namespace {
+
+// Simulations for a hand are dealt in fixed-size chunks, each from its own
+// Philox stream, and workers claim whole chunks. Which thread runs a chunk
+// never changes what it deals, so results do not depend on num_workers.
+constexpr int kSimulationsPerChunk = 1024;
+
+// PREFETCHING: deals gathered per interleaved Two Plus Two call, and the
+// walks it keeps in flight (from BenchmarkInterleavedTwoPlusTwo)
+constexpr int kInterleavedDeals = 32;
+constexpr int kInterleavedWalks = 32;
+
+// Largest deal count a hand may enumerate: it must fit the per-hand
+// simulation count and the 32-bit outcome counters
+constexpr uint64_t kMaxEnumeratedDeals = INT_MAX;
+
+// How often the reporter publishes a hand in progress to shared memory
+constexpr auto kReportInterval = std::chrono::milliseconds(50);
+
+// Precision mode: the first round's chunks per hand, and how much a later
+// round may grow a hand's total when the estimate of what it needs is large
+constexpr int kPrecisionFirstChunks = 4;
+constexpr int kPrecisionMaxGrowth = 4;
+
+// Neyman schedule: a pilot round of up to this many chunks per hand (at
+// most a quarter of the budget), then the rest re-split over this many
+// rounds
+constexpr int kNeymanPilotChunks = 4;
+constexpr int kNeymanRounds = 4;
+
+// High half of the stream ids of board-major chunks, which belong to no
+// one hand
+constexpr uint64_t kSharedBoardStream = uint64_t{0xB0A4D5ED} << 32;
+
+// Preflop matrix jobs deal this many boards per chunk, under this high
+// half of the stream ids
+constexpr int kMatrixBoardsPerChunk = 256;
+constexpr uint64_t kPreflopMatrixStream = uint64_t{0x9F3F1A7B} << 32;
+
+// Kernel tables are indexed by opponent count
+void check_num_opponents(int num_opponents) {
+  if (num_opponents < 0 || num_opponents > EquityEngine::kMaxOpponents) {
+    throw std::invalid_argument("num_opponents must be between 0 and " +
+                                std::to_string(EquityEngine::kMaxOpponents));
+  }
+}
+
+// A preflop matrix job's results: each class against a random hand. Each
+// row pools every matchup it holds, so the binomial error of one matchup
+// over all the boards is a conservative std_error.
+void add_matrix_rows(const PreflopMatrix& matrix,
+                     std::unordered_map<std::string, EquityResult>& results) {
+  const double boards = static_cast<double>(matrix.boards);
+  for (int hand_class = 0; hand_class < kNumHandClasses; ++hand_class) {
+    const double win = matrix.win_rate_vs_random(hand_class);
+    const double tie = matrix.tie_rate_vs_random(hand_class);
+    EquityResult result;
+    result.hand_name = hand_class_name(hand_class);
+    result.equity = win + 0.5 * tie;
+    result.total_simulations = static_cast<uint32_t>(matrix.boards);
+    result.wins = static_cast<uint32_t>(std::lround(win * boards));
+    result.ties = static_cast<uint32_t>(std::lround(tie * boards));
+    result.losses =
+        result.total_simulations - std::min(result.total_simulations, result.wins + result.ties);
+    result.std_error =
+        boards > 0 ? std::sqrt(result.equity * (1.0 - result.equity) / boards) : 0.0;
+    results[result.hand_name] = result;
+  }
+}
+
+// Weighted opponent ranges: one range for every seat, or one per seat,
+// each of two distinct cards with finite non-negative weights
+void check_opponent_ranges(const JobRequest& request) {
+  const size_t ranges = request.opponent_ranges.size();
+  if (ranges > 1 && ranges != static_cast<size_t>(request.num_opponents)) {
+    throw std::invalid_argument("opponent_ranges must hold one range, or one per opponent");
+  }
+  for (const WeightedRange& range : request.opponent_ranges) {
+    for (const WeightedCombo& combo : range) {
+      if (combo.cards[0] == combo.cards[1]) {
+        throw std::invalid_argument("opponent range combo " + combo.cards[0].to_string() +
+                                    combo.cards[1].to_string() + " repeats a card");
+      }
+      if (!std::isfinite(combo.weight) || combo.weight < 0.0) {
+        throw std::invalid_argument("opponent range weights must be finite and non-negative");
+      }
+    }
+  }
+}
+
+// Stable 32-bit id for a hand name (FNV-1a): the high half of its stream ids
+uint32_t hand_stream_id(const std::string& hand_name) {
+  uint32_t hash = 2166136261u;
+  for (char c : hand_name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+// Progress counter, one per pool thread, each on its own cache line
+struct alignas(64) SimulationCounter {
+  std::atomic<uint64_t> value{0};
+};
+
+// The opponent-class counts of the chunks one pool thread merged, for the
+// whole range. Allocated with the thread's first merge, so a job holds one
+// per thread that ran it rather than one per hand.
+struct alignas(64) ClassShard {
+  std::mutex mutex;  // only contended while results are published
+  std::unique_ptr<HandAccumulator> classes;
+};
+
+// One seat's weighted range around one hero hand: the combos its cards and
+// the board leave open, and an alias table over their weights
+struct SeatRange {
+  std::vector<std::array<uint8_t, 2>> combos;
+  std::vector<uint64_t> masks;
+  std::vector<double> weights;
+  AliasTable alias;
+
+  // Draws a combo clear of the cards in `dealt` from the deck's stream. The
+  // first seat's draw always is, so heads-up never redraws; a later seat
+  // redraws a few times, then picks from a scan of the combos still open.
+  std::array<uint8_t, 2> draw(Deck& deck, uint64_t dealt) const {
+    constexpr int kRedraws = 8;
+    const auto columns = static_cast<uint32_t>(combos.size());
+    for (int attempt = 0; attempt < kRedraws; ++attempt) {
+      const uint32_t i = alias.sample(deck.uniform_index(columns), deck.random_bits());
+      if (!(masks[i] & dealt)) return combos[i];
+    }
+    double open = 0.0;
+    for (size_t i = 0; i < combos.size(); ++i) {
+      if (!(masks[i] & dealt)) open += weights[i];
+    }
+    if (open <= 0.0) {
+      throw std::invalid_argument("opponent ranges leave a seat no hand to hold");
+    }
+    double target = open * (deck.random_bits() * 0x1p-32);
+    size_t last_open = 0;
+    for (size_t i = 0; i < combos.size(); ++i) {
+      if (masks[i] & dealt) continue;
+      last_open = i;
+      target -= weights[i];
+      if (target < 0.0) break;
+    }
+    return combos[last_open];
+  }
+};
+
+namespace {
+
+// Each range's open combos around `hole_cards` on `board`. Throws
+// std::invalid_argument if a range has no weight left there.
+std::vector<SeatRange> seat_ranges_for(const std::vector<WeightedRange>& ranges,
+                                       const std::string& hand_name,
+                                       const std::vector<Card>& hole_cards,
+                                       const std::vector<Card>& board) {
+  uint64_t dead = 0;
+  for (const Card& card : hole_cards) dead |= uint64_t{1} << card_id(card);
+  for (const Card& card : board) dead |= uint64_t{1} << card_id(card);
+
+  std::vector<SeatRange> seats(ranges.size());
+  for (size_t r = 0; r < ranges.size(); ++r) {
+    SeatRange& seat = seats[r];
+    for (const WeightedCombo& combo : ranges[r]) {
+      const uint8_t first = card_id(combo.cards[0]);
+      const uint8_t second = card_id(combo.cards[1]);
+      const uint64_t mask = (uint64_t{1} << first) | (uint64_t{1} << second);
+      if ((mask & dead) || combo.weight <= 0.0) continue;
+      seat.combos.push_back({first, second});
+      seat.masks.push_back(mask);
+      seat.weights.push_back(combo.weight);
+    }
+    if (seat.combos.empty()) {
+      throw std::invalid_argument("opponent range " + std::to_string(r) +
+                                  " has no combo open against " + hand_name);
+    }
+    seat.alias = AliasTable(seat.weights);
+  }
+  return seats;
+}
+
+// Heaviest integer weight river_grid gives an opponent combo. A class's
+// counts, up to 12 combos each against at most 1326 opponent combos,
+// then stay within 32 bits.
+constexpr double kMaxRiverWeight = 65536.0;
+
+// A heads-up opponent range as river_grid's per-combo weights: combos the
+// board blocks drop out and repeated ones add up. Integer weights that fit
+// are kept, so weight 1 counts matchups; otherwise every weight is scaled
+// so the heaviest combo weighs kMaxRiverWeight, then rounded. Throws
+// std::invalid_argument if the board leaves no combo any weight.
+ComboWeights river_weights(const WeightedRange& range, const BoardRanks& ranks) {
+  std::array<double, kNumHandCombos> summed{};
+  for (const WeightedCombo& combo : range) {
+    const int index = hand_combo_index(card_id(combo.cards[0]), card_id(combo.cards[1]));
+    if (ranks[index] > 0) summed[index] += combo.weight;
+  }
+  const double heaviest = *std::max_element(summed.begin(), summed.end());
+  if (heaviest <= 0.0) {
+    throw std::invalid_argument("opponent range 0 has no combo open on the board");
+  }
+  const bool integral = std::all_of(summed.begin(), summed.end(),
+                                    [](double weight) { return weight == std::floor(weight); });
+  const double scale =
+      (integral && heaviest <= kMaxRiverWeight) ? 1.0 : kMaxRiverWeight / heaviest;
+
+  ComboWeights weights{};
+  for (int combo = 0; combo < kNumHandCombos; ++combo) {
+    weights[combo] = static_cast<uint32_t>(std::lround(summed[combo] * scale));
+  }
+  return weights;
+}
+
+// Hands of a range that share one simulation: `name` is dealt and every
+// member, itself included, reports its result
+struct IsomorphicHands {
+  const std::string* name;
+  const std::vector<Card>* hole_cards;
+  std::vector<std::string> members;
+};
+
+// Groups the hands of `range_spec` that a relabelling of suits mapping the
+// board onto itself takes to one another: against uniform opponents and
+// runouts they have the same equity, hand types and opponent classes. Each
+// group is dealt as its smallest name, so a seeded job does not depend on
+// map order. With `merge` unset, or for hands that are not two distinct
+// cards, every hand is its own group.
+std::vector<IsomorphicHands> group_isomorphic_hands(
+    const std::unordered_map<std::string, std::vector<Card>>& range_spec,
+    const std::vector<Card>& board, bool merge) {
+  uint64_t board_mask = 0;
+  for (const Card& card : board) board_mask |= uint64_t{1} << card_id(card);
+  std::vector<std::array<uint8_t, 4>> stabilizer;
+  for (const auto& perm : kSuitPermutations) {
+    uint64_t image = 0;
+    for (const Card& card : board) image |= uint64_t{1} << relabel_suit(card_id(card), perm);
+    if (image == board_mask) stabilizer.push_back(perm);
+  }
+
+  std::vector<IsomorphicHands> groups;
+  std::unordered_map<int, size_t> group_of;  // smallest image combo -> group
+  for (const auto& [name, cards] : range_spec) {
+    if (merge && cards.size() == 2 && card_id(cards[0]) != card_id(cards[1])) {
+      int image = kNumHandCombos;
+      for (const auto& perm : stabilizer) {
+        image = std::min(image, hand_combo_index(relabel_suit(card_id(cards[0]), perm),
+                                                 relabel_suit(card_id(cards[1]), perm)));
+      }
+      const auto [it, inserted] = group_of.try_emplace(image, groups.size());
+      if (!inserted) {
+        IsomorphicHands& group = groups[it->second];
+        group.members.push_back(name);
+        if (name < *group.name) {
+          group.name = &name;
+          group.hole_cards = &cards;
+        }
+        continue;
+      }
+    }
+    groups.push_back({&name, &cards, {name}});
+  }
+  return groups;
+}
+
+}  // namespace
+
+struct EquityEngine::HandTask {
+  HandTask(std::string name, const std::vector<Card>& hole_cards, const std::vector<Card>& board,
+           uint64_t seed, uint64_t hand_stream, int simulations, const RunoutRanks* ranks)
+      : name(std::move(name)),
+        hole_cards(hole_cards),
+        board(board),
+        seed(seed),
+        hand_stream(hand_stream),
+        simulations(simulations),
+        max_chunks((simulations + kSimulationsPerChunk - 1) / kSimulationsPerChunk),
+        ranks(ranks) {}
+
+  std::string name;
+  const std::vector<Card>& hole_cards;
+  const std::vector<Card>& board;
+  uint64_t seed;
+  uint64_t hand_stream;  // high half of this hand's chunk stream ids
+  int simulations;       // cap: chunks past it are never run
+  int max_chunks;
+  const RunoutRanks* ranks;  // BOARD_CACHE: the job's rank vectors, or null
+  // Opponent ranges: seat o draws from seats[min(o, seats.size() - 1)]
+  std::vector<SeatRange> seats;
+  // Range hands this one's result stands for, its own name included
+  std::vector<std::string> members;
+
+  // Scheduling, written by the job's thread between rounds: chunks
+  // [round_first, chunks_issued) run this round, and if last_round is set
+  // the hand finishes once they have all merged
+  int round_first = 0;
+  int chunks_issued = 0;
+  bool last_round = false;
+
+  // Chunks of this round not yet merged
+  std::atomic<int> chunks_left{0};
+  // Merged chunks' results, over every opponent class; the job's class
+  // shards hold them by class
+  std::mutex mutex;
+  OutcomeCounts counts;
+  bool finished = false;  // guarded by the job's mutex
+};
+
+struct EquityEngine::RangeJob {
+  explicit RangeJob(int counter_slots) : counters(counter_slots), class_shards(counter_slots) {}
+
+  WorkerFn kernel = nullptr;
+  std::optional<double> target_std_error;
+  Schedule schedule = Schedule::UNIFORM;
+  int budget_chunks = 0;  // NEYMAN: chunks to spread over all hands
+  int round = 0;
+  // Simulations the job will run, for progress; 0 if not known up front
+  uint64_t planned_simulations = 0;
+  bool exact = false;  // every deal enumerated
+  std::unique_ptr<RunoutRanks> ranks;  // BOARD_CACHE, when it pays off
+
+  // BOARD_MAJOR: one kernel for the whole range over `board_deals` deals
+  BoardWorkerFn board_kernel = nullptr;
+  const std::vector<Card>* board = nullptr;
+  uint64_t seed = 0;
+  int board_deals = 0;
+
+  std::vector<std::unique_ptr<HandTask>> hands;
+  // Indexed by pool thread; the last slot is for threads off the pool
+  std::vector<SimulationCounter> counters;
+  std::vector<ClassShard> class_shards;
+
+  // The calling thread's slot in counters and class_shards
+  size_t thread_slot() const {
+    const int worker = ThreadPool::current_worker();
+    return (worker >= 0 && static_cast<size_t>(worker) + 1 < counters.size())
+               ? static_cast<size_t>(worker)
+               : counters.size() - 1;
+  }
+
+  // The calling thread's class shard, held by `lock`
+  HandAccumulator& thread_classes(std::unique_lock<std::mutex>& lock) {
+    ClassShard& shard = class_shards[thread_slot()];
+    lock = std::unique_lock<std::mutex>(shard.mutex);
+    if (!shard.classes) shard.classes = std::make_unique<HandAccumulator>();
+    return *shard.classes;
+  }
+
+  // Drains a chunk of `hand` into its counts and the calling thread's
+  // class shard, which counts it once per member
+  void merge(HandTask& hand, HandAccumulator& chunk) {
+    {
+      std::lock_guard<std::mutex> lock(hand.mutex);
+      hand.counts += chunk.total();
+    }
+    std::unique_lock<std::mutex> lock;
+    chunk.drain_into(thread_classes(lock), hand.members.size());
+  }
+
+  // Guards everything below and each HandTask::finished
+  std::mutex mutex;
+  std::unordered_map<std::string, EquityResult> hand_results;
+  size_t hands_finished = 0;
+
+  // Reporter state
+  size_t hands_reported = 0;
+  int rounds_reported = 0;
+  ThreadPool::Stats last_pool_stats;
+  std::chrono::steady_clock::time_point last_report = std::chrono::steady_clock::now();
+};
+
+namespace {
+
+// Each thread's scratch accumulator for the chunk it is running
+HandAccumulator& chunk_scratch() {
+  thread_local auto scratch = std::make_unique<HandAccumulator>();
+  return *scratch;
+}
+
+}  // namespace
+
+EquityEngine::EquityEngine(const std::string& mode, const std::string& job_id,
+                           const EvaluatorRegistry& evaluators)
+    : evaluators_(evaluators), mode_(mode) {
 
     // Create shared memory writer if job_id provided
     if (!job_id.empty()) {
@@ -33,53 +424,175 @@ std::unordered_map<std::string, EquityResult> EquityEngine::calculate_range_equi
     const JobRequest& request) {
 
     std::unordered_map<std::string, EquityResult> results;
-    simulations_processed_ = 0;
-    last_update_count_ = 0;
 
-    std::vector<std::string> hand_names;
-    for (const auto& pair : request.range_spec) {
-        hand_names.push_back(pair.first);
+    // A compiled range runs as the range_spec of its unblocked combos
+    if (request.range) {
+        JobRequest expanded = request;
+        expanded.range.reset();
+        uint64_t board_mask = 0;
+        for (const Card& card : request.board) board_mask |= uint64_t{1} << card_id(card);
+        const ComboSet combos = request.range->combos - ComboSet::holding(board_mask);
+        combos.for_each([&expanded](int combo) {
+            const auto& cards = hand_index_tables::kComboCards[combo];
+            expanded.range_spec[combo_name(combo)] = {card_from_id(cards[1]), card_from_id(cards[0])};
+        });
+        return calculate_range_equity(expanded);
     }
 
-    size_t total_hands = hand_names.size();
-    if (total_hands == 0) return results;
+    // The matrix is over every class, whatever range_spec holds
+    const bool matrix = is_preflop_matrix_mode(request.mode);
+    size_t total_hands = request.range_spec.size();
+    if (total_hands == 0 && !matrix) return results;
 
-    int simulations_per_hand = request.num_simulations / total_hands;
+    int simulations_per_hand = total_hands ? request.num_simulations / total_hands : 0;
+    const uint64_t seed = request.seed ? *request.seed : random_seed();
 
     try {
-        for (size_t idx = 0; idx < hand_names.size(); ++idx) {
-            const std::string& hand_name = hand_names[idx];
-
-            EquityResult overall = calculate_hand_equity(
-                request,
-                hand_name,
-                simulations_per_hand,
-                results
-            );
+        check_opponent_ranges(request);
+        const bool weighted = !request.opponent_ranges.empty();
 
-            results[hand_name] = overall;
-
-            if (shm_writer_) {
-                uint64_t expected_total = (idx + 1) * simulations_per_hand;
-                if (simulations_processed_ < expected_total) {
-                    simulations_processed_ = expected_total;
+        if (is_river_grid_mode(request.mode) || matrix) {
+            if (matrix) {
+                if (weighted) {
+                    throw std::invalid_argument(
+                        request.mode + " plays random hands; opponent_ranges are not supported");
                 }
-                shm_writer_->update_hands(simulations_processed_);
+                preflop_matrix_ =
+                    std::make_shared<const PreflopMatrix>(calculate_preflop_matrix(request));
+                add_matrix_rows(*preflop_matrix_, results);
+            } else {
+                solve_river_grid(request, results);
+            }
+            if (shm_writer_) {
                 shm_writer_->update_equity_results(results);
+                shm_writer_->set_status(1);  // Completed
+                shm_writer_->close();
             }
+            return results;
+        }
 
-            double progress = static_cast<double>(idx + 1) / total_hands;
-            if (progress_callback_) {
-                std::unordered_map<std::string, double> current_results;
-                for (const auto& pair : results) {
-                    current_results[pair.first] = pair.second.equity;
-                }
-                progress_callback_(progress, current_results);
+        // Request options are parsed once per job into the kernel that runs
+        // them; the simulation loop never sees the strings
+        uint8_t optimization_flags = parse_optimization_flags(request.optimizations);
+
+        // Enumerate every deal when asked to, or when there are no more
+        // deals than the simulations we would sample: exact and no slower.
+        // The enumerator deals uniform opponents, so weighted ranges sample.
+        const uint64_t deals =
+            RunoutEnumerator::count(static_cast<int>(request.board.size()), request.num_opponents);
+        if (weighted && (optimization_flags & EXHAUSTIVE)) {
+            throw std::invalid_argument("exhaustive enumeration does not support opponent_ranges");
+        }
+        if (!weighted && deals > 0 &&
+            deals <= static_cast<uint64_t>(std::max(simulations_per_hand, 0))) {
+            optimization_flags |= EXHAUSTIVE;
+        }
+        if ((optimization_flags & EXHAUSTIVE) && deals > kMaxEnumeratedDeals) {
+            throw std::invalid_argument("too many deals to enumerate (" + std::to_string(deals) +
+                                        " per hand); use Monte Carlo");
+        }
+        int hand_simulations =
+            (optimization_flags & EXHAUSTIVE) ? static_cast<int>(deals) : simulations_per_hand;
+
+        ThreadPool& pool = ThreadPool::instance();
+        RangeJob job(pool.size() + 1);
+        const EvaluatorType evaluator = parse_evaluator_type(request.algorithm);
+        const bool parallel = (optimization_flags & MULTITHREADING) && request.num_workers > 1;
+        // Board-major deals opponents once for the whole range, which
+        // weighted ranges (conditioned on each hero hand) cannot share
+        const bool board_major =
+            (optimization_flags & BOARD_MAJOR) && !(optimization_flags & EXHAUSTIVE) && !weighted;
+
+        // Suit-isomorphic hands are dealt once, as one hand: a group costs
+        // one hand's simulations (or enumeration) and reports the result
+        // under every member's name. Weighted ranges are not symmetric
+        // under relabelling, and board-major already shares every deal
+        // across the range.
+        const std::vector<IsomorphicHands> groups =
+            group_isomorphic_hands(request.range_spec, request.board, !weighted && !board_major);
+
+        // Look every showdown up in per-board rank vectors when filling the
+        // ones the cache lacks costs fewer evaluations than the job's
+        // showdowns. The batch paths then have nothing left to evaluate.
+        if ((optimization_flags & BOARD_CACHE) &&
+            RunoutRanks::count(static_cast<int>(request.board.size())) > 0) {
+            std::vector<uint8_t> board_ids;
+            for (const Card& card : request.board) board_ids.push_back(card_id(card));
+            const uint64_t showdowns =
+                board_major ? static_cast<uint64_t>(simulations_per_hand) *
+                                  (total_hands + request.num_opponents)
+                            : static_cast<uint64_t>(hand_simulations) * groups.size() *
+                                  (request.num_opponents + 1);
+            BoardRankCache& cache = BoardRankCache::instance();
+            const auto tag = static_cast<uint8_t>(evaluator);
+            const uint64_t missing = RunoutRanks::missing(cache, tag, board_ids);
+            if (missing * kNumHandCombos <= showdowns) {
+                job.ranks = std::make_unique<RunoutRanks>(cache, tag, board_ids,
+                                                          board_rank_filler(evaluator),
+                                                          parallel ? &pool : nullptr);
+                optimization_flags &= ~(SIMD | PREFETCHING);
+            }
+        }
+
+        job.kernel = select_worker(evaluator, optimization_flags, request.num_opponents, weighted);
+        job.exact = optimization_flags & EXHAUSTIVE;
+        if (!job.exact) {
+            job.target_std_error = request.target_std_error;
+            if (!job.target_std_error) job.schedule = parse_schedule(request.schedule);
+        }
+        job.last_pool_stats = pool.stats();
+
+        // Under NEYMAN any hand may end up with most of the budget, which
+        // is the simulated hands' share of num_simulations
+        if (job.schedule == Schedule::NEYMAN) {
+            hand_simulations = request.num_simulations;
+            job.budget_chunks = static_cast<int>(
+                static_cast<uint64_t>(request.num_simulations) * groups.size() / total_hands /
+                kSimulationsPerChunk);
+        }
+        for (const IsomorphicHands& group : groups) {
+            job.hands.push_back(std::make_unique<HandTask>(
+                *group.name, *group.hole_cards, request.board, seed,
+                static_cast<uint64_t>(hand_stream_id(*group.name)) << 32, hand_simulations,
+                job.ranks.get()));
+            job.hands.back()->members = group.members;
+            if (weighted) {
+                job.hands.back()->seats = seat_ranges_for(request.opponent_ranges, *group.name,
+                                                          *group.hole_cards, request.board);
+            }
+            if (job.schedule != Schedule::NEYMAN && !job.target_std_error) {
+                job.planned_simulations += static_cast<uint64_t>(hand_simulations);
+            }
+            if (job.hands.back()->max_chunks == 0) finish_hand(job, *job.hands.back());
+        }
+        if (job.schedule == Schedule::NEYMAN) {
+            job.planned_simulations = static_cast<uint64_t>(job.budget_chunks) * kSimulationsPerChunk;
+        }
+
+        if (board_major) {
+            // Every hand shares num_simulations / hands deals; schedules
+            // and precision targets, which split work per hand, do not apply
+            job.board_kernel = select_board_worker(evaluator, request.num_opponents);
+            job.board = &request.board;
+            job.seed = seed;
+            job.board_deals = simulations_per_hand;
+            run_board_major(job, parallel, results);
+        } else {
+            // Each round plans more chunks for the unfinished hands and
+            // runs them; UNIFORM plans them all in the first. Plans only
+            // look at rounds that have fully merged, so a seeded job runs
+            // the same chunks whatever the number of threads, and
+            // PROGRESSIVE ends with exactly UNIFORM's results.
+            while (plan_round(job)) {
+                run_round(job, parallel, results);
             }
         }
 
+        report_progress(job, results);
+        publish_results(job, false, results);
+
         if (shm_writer_) {
-            shm_writer_->update_hands(simulations_processed_);
+            shm_writer_->update_equity_results(results);
             shm_writer_->set_status(1);  // Completed
             shm_writer_->close();
         }
@@ -95,287 +608,1107 @@ std::unordered_map<std::string, EquityResult> EquityEngine::calculate_range_equi
     return results;
 }
 
-EquityResult EquityEngine::calculate_hand_equity(
-    const JobRequest& request,
-    const std::string& hand_name,
-    int simulations_per_hand,
-    std::unordered_map<std::string, EquityResult>& results) {
-
-  // Check if MULTITHREADING optimization is enabled
-  auto has_multithreading = std::any_of(request.optimizations.begin(), request.optimizations.end(),
-                                         [](const std::string& opt) {
-                                           std::string opt_lower = opt;
-                                           std::transform(opt_lower.begin(), opt_lower.end(), opt_lower.begin(), ::tolower);
-                                           return opt_lower == "multithreading";
-                                         });
-
-  // Only use multiple workers if MULTITHREADING optimization is enabled
-  int num_workers = (has_multithreading && request.num_workers > 0) ? request.num_workers : 1;
-  std::mutex results_mutex;
-  const int update_interval = 1000;
-
-  const std::vector<Card>& hole_cards = request.range_spec.at(hand_name);
-
-  auto run_worker = [&](int worker_sims) {
-    std::unordered_map<std::string, EquityResult> local_opponent_stats;
-    Deck deck;
-
-    // Check if SIMD optimization is enabled (case-insensitive)
-    std::string algo_lower = request.algorithm;
-    std::transform(algo_lower.begin(), algo_lower.end(), algo_lower.begin(), ::tolower);
-
-    auto has_simd = std::any_of(request.optimizations.begin(), request.optimizations.end(),
-                                 [](const std::string& opt) {
-                                   std::string opt_lower = opt;
-                                   std::transform(opt_lower.begin(), opt_lower.end(), opt_lower.begin(), ::tolower);
-                                   return opt_lower == "simd";
-                                 });
-
-    bool use_simd = ((algo_lower == "omp" || algo_lower == "omp_eval") && has_simd);
-
-    int sim_num = 0;
-    while (sim_num < worker_sims) {
-      if (use_simd && (worker_sims - sim_num) >= SIMDConfig::kBatchSize) {
-        // SIMD Path: Process 8 simulations in a batch
-        HandBatch our_batch;
-        HandBatch opp_batch;
-        std::vector<std::string> opp_classes(SIMDConfig::kBatchSize);
-
-        for (int b = 0; b < SIMDConfig::kBatchSize; ++b) {
-          deck.reset();
-          for (const auto& card : hole_cards) deck.remove(card);
-          for (const auto& card : request.board) deck.remove(card);
-
-          std::vector<Card> board_cards = request.board;
-          int remaining_board = 5 - static_cast<int>(request.board.size());
-          for (int i = 0; i < remaining_board; ++i) {
-            board_cards.push_back(deck.draw_random());
-          }
+void EquityEngine::solve_river_grid(const JobRequest& request,
+                                    std::unordered_map<std::string, EquityResult>& results) {
+  if (request.board.size() != 5) {
+    throw std::invalid_argument("river_grid needs a complete board (5 cards)");
+  }
+  if (request.num_opponents != 1) {
+    throw std::invalid_argument("river_grid is heads-up: num_opponents must be 1");
+  }
 
-          std::vector<std::vector<Card>> opponent_hands;
-          for (int i = 0; i < request.num_opponents; ++i) {
-            opponent_hands.push_back(deck.sample(2));
-          }
+  const EvaluatorType evaluator = parse_evaluator_type(request.algorithm);
+  std::array<uint8_t, 5> board;
+  for (int i = 0; i < 5; ++i) board[i] = card_id(request.board[i]);
+  const auto ranks = BoardRankCache::instance().get(static_cast<uint8_t>(evaluator), board,
+                                                    board_rank_filler(evaluator));
+  // check_opponent_ranges() leaves heads-up at most one range
+  const ComboWeights opponents = request.opponent_ranges.empty()
+                                     ? RiverSolver::uniform_weights(*ranks)
+                                     : river_weights(request.opponent_ranges[0], *ranks);
+  const RiverSolver solver(*ranks, opponents);
 
-          size_t opp_idx = 0;  // Assume 1 opponent for batching test
-          const std::vector<Card>& opp_hand = opponent_hands[opp_idx];
-          opp_classes[b] = naive_evaluator_.classify_hole_cards(opp_hand);
+  // Adds a combo's showdowns into one class's (or hand's) counts
+  auto add_combo = [&solver, &ranks](int combo, OutcomeCounts& counts) {
+    const ComboShowdown showdown = solver.solve(combo);
+    counts.wins += static_cast<uint32_t>(showdown.wins);
+    counts.ties += static_cast<uint32_t>(showdown.ties);
+    counts.losses += static_cast<uint32_t>(showdown.losses);
+    counts.total += static_cast<uint32_t>(showdown.total);
+    const int our_type = get_hand_type((*ranks)[combo]);
+    for (int t = 0; t < 10; ++t) {
+      counts.win_method_matrix[our_type][t] += static_cast<uint32_t>(showdown.wins_by_opp_type[t]);
+      counts.loss_method_matrix[t][our_type] += static_cast<uint32_t>(showdown.losses_by_opp_type[t]);
+    }
+  };
+  auto publish = [&results](const std::string& name, const OutcomeCounts& counts) {
+    EquityResult result;
+    result.hand_name = name;
+    add_to_result(counts, result);
+    result.std_error = 0.0;  // exact
+    results[name] = result;
+  };
 
-          // Pack into SoA HandBatch
+  // Each class over its combos that miss the board
+  std::vector<OutcomeCounts> classes(kNumHandClasses);
+  for (int combo = 0; combo < kNumHandCombos; ++combo) {
+    if ((*ranks)[combo] > 0) add_combo(combo, classes[hand_index_tables::kClassOfCombo[combo]]);
+  }
+  for (int hand_class = 0; hand_class < kNumHandClasses; ++hand_class) {
+    if (classes[hand_class].total > 0) publish(hand_class_name(hand_class), classes[hand_class]);
+  }
+
+  // A spec hand replaces a class of the same name
+  for (const auto& pair : request.range_spec) {
+    if (pair.second.size() != 2) {
+      throw std::invalid_argument("hand " + pair.first + " must have 2 hole cards");
+    }
+    OutcomeCounts counts;
+    const int combo = hand_combo_index(card_id(pair.second[0]), card_id(pair.second[1]));
+    if ((*ranks)[combo] > 0) {
+      add_combo(combo, counts);
+      if (counts.total == 0) {
+        throw std::invalid_argument("opponent range 0 has no combo open against " + pair.first);
+      }
+    }
+    publish(pair.first, counts);
+  }
+}
+
+PreflopMatrix EquityEngine::calculate_preflop_matrix(const JobRequest& request) {
+  if (!request.board.empty()) {
+    throw std::invalid_argument("preflop_matrix is preflop: the board must be empty");
+  }
+  if (request.num_opponents != 1) {
+    throw std::invalid_argument("preflop_matrix is heads-up: num_opponents must be 1");
+  }
+  const MatrixMatchups& matchups = matrix_matchups();
+  const BoardRankCache::Fill fill = board_rank_filler(parse_evaluator_type(request.algorithm));
+  const uint64_t seed = request.seed ? *request.seed : random_seed();
+  const int boards = std::max(request.num_simulations, 0);
+  const int chunks = (boards + kMatrixBoardsPerChunk - 1) / kMatrixBoardsPerChunk;
+
+  // Each chunk deals its boards from its own stream into its thread's
+  // counts, then adds them to the job's: integer sums, so the result does
+  // not depend on which thread ran what
+  MatchupCounts counts(matchups.size());
+  std::mutex counts_mutex;
+  auto run_chunk = [&](int chunk) {
+    thread_local MatchupCounts scratch;
+    if (scratch.wins.size() != matchups.size()) {
+      scratch = MatchupCounts(matchups.size());
+    } else {
+      scratch.clear();
+    }
+    Deck deck(seed, kPreflopMatrixStream | static_cast<uint32_t>(chunk));
+    Card cards[5];
+    std::array<uint8_t, 5> board;
+    BoardRanks ranks;
+    const int chunk_boards =
+        std::min(kMatrixBoardsPerChunk, boards - chunk * kMatrixBoardsPerChunk);
+    for (int b = 0; b < chunk_boards; ++b) {
+      deck.reset();
+      deck.sample_into(cards, 5);
+      uint64_t board_mask = 0;
+      for (int i = 0; i < 5; ++i) {
+        board[i] = card_id(cards[i]);
+        board_mask |= uint64_t{1} << board[i];
+      }
+      fill(board, ranks);
+      for (size_t m = 0; m < matchups.size(); ++m) {
+        if (matchups.mask[m] & board_mask) continue;
+        const int32_t hero = ranks[matchups.hero[m]];
+        const int32_t villain = ranks[matchups.villain[m]];
+        scratch.total[m]++;
+        scratch.wins[m] += hero > villain;
+        scratch.ties[m] += hero == villain;
+      }
+    }
+    std::lock_guard<std::mutex> lock(counts_mutex);
+    counts += scratch;
+  };
+
+  // Rounds of chunks on the pool, with progress between them
+  ThreadPool& pool = ThreadPool::instance();
+  const bool parallel = (parse_optimization_flags(request.optimizations) & MULTITHREADING) &&
+                        request.num_workers > 1;
+  const int round_chunks = parallel ? std::max(1, 4 * pool.size()) : 16;
+  for (int first = 0; first < chunks; first += round_chunks) {
+    const int last = std::min(chunks, first + round_chunks);
+    if (parallel) {
+      TaskGroup group(pool);
+      for (int chunk = first; chunk < last; ++chunk) {
+        group.run([&run_chunk, chunk] { run_chunk(chunk); });
+      }
+      group.wait();
+    } else {
+      for (int chunk = first; chunk < last; ++chunk) run_chunk(chunk);
+    }
+    if (progress_callback_) progress_callback_(static_cast<double>(last) / chunks, {});
+  }
+
+  return assemble_preflop_matrix(matchups, counts, static_cast<uint64_t>(boards));
+}
+
+template <EvaluatorType kEvaluator>
+const auto& EquityEngine::evaluator() const {
+  if constexpr (kEvaluator == EvaluatorType::CACTUS_KEV) {
+    return evaluators_.cactus_kev();
+  } else if constexpr (kEvaluator == EvaluatorType::PH_EVALUATOR) {
+    return evaluators_.ph();
+  } else if constexpr (kEvaluator == EvaluatorType::TWO_PLUS_TWO) {
+    return evaluators_.two_plus_two();
+  } else if constexpr (kEvaluator == EvaluatorType::OMP_EVAL) {
+    return evaluators_.omp();
+  } else {
+    return evaluators_.naive();
+  }
+}
+
+template <EvaluatorType kEvaluator>
+int32_t EquityEngine::evaluate(CardIds cards) const {
+  return evaluator<kEvaluator>().evaluate(cards);
+}
+
+template <EvaluatorType kEvaluator>
+int32_t EquityEngine::showdown_value(const int32_t* board_ranks, CardIds cards) const {
+  if (board_ranks) return board_ranks[hand_combo_index(cards[0], cards[1])];
+  return evaluate<kEvaluator>(cards);
+}
+
+template <EvaluatorType kEvaluator>
+void EquityEngine::fill_board_ranks(const std::array<uint8_t, 5>& board, BoardRanks& ranks) const {
+  uint64_t board_mask = 0;
+  for (uint8_t id : board) board_mask |= 1ULL << id;
+  ranks.fill(0);
+
+  if constexpr (kEvaluator == EvaluatorType::OMP_EVAL) {
+    // Live combos go through the batch kernel, the last batch padded with
+    // repeats of its first lane
+    HandBatch batch;
+    for (int i = 0; i < 5; ++i) {
+      for (int b = 0; b < SIMDConfig::kMaxBatchSize; ++b) {
+        batch.ranks[i + 2][b] = board[i] / 4 + 2;
+        batch.suits[i + 2][b] = board[i] % 4;
+      }
+    }
+    const int batch_size = evaluators_.omp().batch_size();
+    int lane_combo[SIMDConfig::kMaxBatchSize];
+    int32_t values[SIMDConfig::kMaxBatchSize];
+    int lanes = 0;
+    auto flush = [&] {
+      for (int b = lanes; b < batch_size; ++b) {
+        for (int i = 0; i < 2; ++i) {
+          batch.ranks[i][b] = batch.ranks[i][0];
+          batch.suits[i][b] = batch.suits[i][0];
+        }
+      }
+      evaluators_.omp().evaluate_batch(batch, values);
+      for (int b = 0; b < lanes; ++b) ranks[lane_combo[b]] = values[b];
+      lanes = 0;
+    };
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+      const auto& cards = hand_index_tables::kComboCards[combo];
+      if (board_mask & ((1ULL << cards[0]) | (1ULL << cards[1]))) continue;
+      for (int i = 0; i < 2; ++i) {
+        batch.ranks[i][lanes] = cards[i] / 4 + 2;
+        batch.suits[i][lanes] = cards[i] % 4;
+      }
+      lane_combo[lanes++] = combo;
+      if (lanes == batch_size) flush();
+    }
+    if (lanes > 0) flush();
+  } else {
+    uint8_t hand_ids[kMaxHandCards];
+    std::copy(board.begin(), board.end(), hand_ids + 2);
+    const CardIds hand(hand_ids, kMaxHandCards);
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+      const auto& cards = hand_index_tables::kComboCards[combo];
+      if (board_mask & ((1ULL << cards[0]) | (1ULL << cards[1]))) continue;
+      hand_ids[0] = cards[0];
+      hand_ids[1] = cards[1];
+      ranks[combo] = evaluate<kEvaluator>(hand);
+    }
+  }
+}
+
+BoardRankCache::Fill EquityEngine::board_rank_filler(EvaluatorType evaluator) const {
+  auto filler = [this]<EvaluatorType kEvaluator>() -> BoardRankCache::Fill {
+    return [this](const std::array<uint8_t, 5>& board, BoardRanks& ranks) {
+      fill_board_ranks<kEvaluator>(board, ranks);
+    };
+  };
+  switch (evaluator) {
+    case EvaluatorType::CACTUS_KEV:
+      return filler.operator()<EvaluatorType::CACTUS_KEV>();
+    case EvaluatorType::PH_EVALUATOR:
+      return filler.operator()<EvaluatorType::PH_EVALUATOR>();
+    case EvaluatorType::TWO_PLUS_TWO:
+      return filler.operator()<EvaluatorType::TWO_PLUS_TWO>();
+    case EvaluatorType::OMP_EVAL:
+      return filler.operator()<EvaluatorType::OMP_EVAL>();
+    case EvaluatorType::NAIVE:
+      break;
+  }
+  return filler.operator()<EvaluatorType::NAIVE>();
+}
+
+template <EvaluatorType kEvaluator, bool kBatch, int kOpponents>
+void EquityEngine::run_chunk(const HandTask& task, int chunk, HandAccumulator& classes) {
+  constexpr bool kSimd = kBatch && kEvaluator == EvaluatorType::OMP_EVAL;
+  constexpr bool kInterleaved = kBatch && kEvaluator == EvaluatorType::TWO_PLUS_TWO;
+  static_assert(!kBatch || ((kSimd || kInterleaved) && kOpponents > 0),
+                "the batch paths are OMPEval's and Two Plus Two's and need an opponent");
+
+  // Hole cards and board are dead for every simulation of this hand, so
+  // they come out of the deck template once and reset() restores the rest.
+  // The chunk's own Philox stream makes what it deals independent of which
+  // thread runs it.
+  Deck deck(task.seed, task.hand_stream | static_cast<uint32_t>(chunk));
+  std::vector<Card> dead_cards = task.hole_cards;
+  dead_cards.insert(dead_cards.end(), task.board.begin(), task.board.end());
+  deck.set_dead_cards(dead_cards);
+
+  // Dealing buffers reused across simulations
+  const size_t known_board = task.board.size();
+  const int remaining_board = 5 - static_cast<int>(known_board);
+  std::array<Card, 5> board_cards;
+  std::copy(task.board.begin(), task.board.end(), board_cards.begin());
+  std::array<std::array<Card, 2>, kOpponents> opponent_hands;
+
+  // Batch buffers: one hero batch plus one batch (and the dealt hands'
+  // classes) per opponent seat
+  constexpr int kBatchSeats = kSimd ? kOpponents : 0;
+  HandBatch our_batch;
+  std::array<HandBatch, kBatchSeats> opp_batches;
+  std::array<std::array<uint8_t, SIMDConfig::kMaxBatchSize>, kBatchSeats> opp_classes;
+  const int batch_size = evaluators_.omp().batch_size();
+
+  const int chunk_sims = std::min(kSimulationsPerChunk,
+                                  task.simulations - chunk * kSimulationsPerChunk);
+
+  int sim_num = 0;
+  if constexpr (kSimd) {
+    // SIMD Path: Process 8 (16 with AVX-512) simulations per batch while
+    // a whole batch fits in the chunk
+    for (; chunk_sims - sim_num >= batch_size; sim_num += batch_size) {
+      for (int b = 0; b < batch_size; ++b) {
+        deck.reset();
+        deck.sample_into(board_cards.data() + known_board, remaining_board);
+
+        // Pack into SoA HandBatch
+        for (int i = 0; i < 2; ++i) {
+          our_batch.ranks[i][b] = task.hole_cards[i].rank;
+          our_batch.suits[i][b] = task.hole_cards[i].suit;
+        }
+        for (int i = 0; i < 5; ++i) {
+          our_batch.ranks[i + 2][b] = board_cards[i].rank;
+          our_batch.suits[i + 2][b] = board_cards[i].suit;
+        }
+
+        for (int o = 0; o < kOpponents; ++o) {
+          Card opp_hand[2];
+          deck.sample_into(opp_hand, 2);
+          opp_classes[o][b] = static_cast<uint8_t>(hand_class_of(opp_hand[0], opp_hand[1]));
+          HandBatch& opp_batch = opp_batches[o];
           for (int i = 0; i < 2; ++i) {
-            our_batch.ranks[i][b] = hole_cards[i].rank;
-            our_batch.suits[i][b] = hole_cards[i].suit;
             opp_batch.ranks[i][b] = opp_hand[i].rank;
             opp_batch.suits[i][b] = opp_hand[i].suit;
           }
           for (int i = 0; i < 5; ++i) {
-            our_batch.ranks[i + 2][b] = board_cards[i].rank;
-            our_batch.suits[i + 2][b] = board_cards[i].suit;
             opp_batch.ranks[i + 2][b] = board_cards[i].rank;
             opp_batch.suits[i + 2][b] = board_cards[i].suit;
           }
         }
+      }
 
-        int32_t our_results[SIMDConfig::kBatchSize];
-        int32_t opp_results[SIMDConfig::kBatchSize];
-        omp_evaluator_.evaluate_batch(our_batch, our_results);
-        omp_evaluator_.evaluate_batch(opp_batch, opp_results);
-
-        for (int b = 0; b < SIMDConfig::kBatchSize; ++b) {
-          std::string& opp_class = opp_classes[b];
-          if (local_opponent_stats.find(opp_class) ==
-              local_opponent_stats.end()) {
-            local_opponent_stats[opp_class] = EquityResult();
-            local_opponent_stats[opp_class].hand_name = opp_class;
-          }
-          EquityResult& stats = local_opponent_stats[opp_class];
-          stats.total_simulations++;
-
-          if (our_results[b] > opp_results[b]) {
-            stats.wins++;
-            stats.win_method_matrix[get_hand_type(our_results[b])]
-                                   [get_hand_type(opp_results[b])]++;
-          } else if (our_results[b] == opp_results[b]) {
-            stats.ties++;
-          } else {
-            stats.losses++;
-            stats.loss_method_matrix[get_hand_type(opp_results[b])]
-                                    [get_hand_type(our_results[b])]++;
+      int32_t our_results[SIMDConfig::kMaxBatchSize];
+      int32_t opp_results[SIMDConfig::kMaxBatchSize];
+      int32_t max_opp[SIMDConfig::kMaxBatchSize] = {0};
+      int max_opp_idx[SIMDConfig::kMaxBatchSize] = {0};
+      evaluators_.omp().evaluate_batch(our_batch, our_results);
+      for (int o = 0; o < kOpponents; ++o) {
+        evaluators_.omp().evaluate_batch(opp_batches[o], opp_results);
+        for (int b = 0; b < batch_size; ++b) {
+          if (opp_results[b] > max_opp[b]) {
+            max_opp[b] = opp_results[b];
+            max_opp_idx[b] = o;
           }
         }
-        sim_num += SIMDConfig::kBatchSize;
-        simulations_processed_ += SIMDConfig::kBatchSize;
-      } else {
-        // Scalar Path
+      }
+
+      for (int b = 0; b < batch_size; ++b) {
+        classes.record(opp_classes[max_opp_idx[b]][b], our_results[b], max_opp[b]);
+      }
+    }
+  }
+
+  if constexpr (kInterleaved) {
+    // Interleaved Path: every seat's hand of kInterleavedDeals deals goes
+    // into one evaluate_interleaved call, so kInterleavedWalks table walks
+    // are in flight at once. Deals in the same order as the scalar path,
+    // so results are identical.
+    constexpr int kSeats = kOpponents + 1;
+    uint8_t walk_hands[kInterleavedDeals * kSeats][kMaxHandCards];
+    int32_t values[kInterleavedDeals * kSeats];
+    std::array<std::array<std::array<Card, 2>, kOpponents>, kInterleavedDeals> dealt;
+    for (; chunk_sims - sim_num >= kInterleavedDeals; sim_num += kInterleavedDeals) {
+      for (int d = 0; d < kInterleavedDeals; ++d) {
         deck.reset();
-        for (const auto& card : hole_cards) deck.remove(card);
-        for (const auto& card : request.board) deck.remove(card);
+        deck.sample_into(board_cards.data() + known_board, remaining_board);
+        for (auto& opp_hand : dealt[d]) {
+          deck.sample_into(opp_hand.data(), 2);
+        }
+
+        // Seat 0 is the hero; each seat's hole cards, then the board
+        uint8_t (*seats)[kMaxHandCards] = walk_hands + d * kSeats;
+        seats[0][0] = card_id(task.hole_cards[0]);
+        seats[0][1] = card_id(task.hole_cards[1]);
+        for (int o = 0; o < kOpponents; ++o) {
+          seats[o + 1][0] = card_id(dealt[d][o][0]);
+          seats[o + 1][1] = card_id(dealt[d][o][1]);
+        }
+        for (int i = 0; i < 5; ++i) {
+          const uint8_t id = card_id(board_cards[i]);
+          for (int seat = 0; seat < kSeats; ++seat) seats[seat][i + 2] = id;
+        }
+      }
+
+      evaluators_.two_plus_two().evaluate_interleaved<kInterleavedWalks>(
+          walk_hands, kInterleavedDeals * kSeats, values);
 
-        std::vector<Card> board_cards = request.board;
-        int remaining_board = 5 - static_cast<int>(request.board.size());
-        for (int i = 0; i < remaining_board; ++i) {
-          board_cards.push_back(deck.draw_random());
+      for (int d = 0; d < kInterleavedDeals; ++d) {
+        const int32_t* seat_values = values + d * kSeats;
+        int32_t max_opponent = 0;
+        int max_opp_idx = 0;
+        for (int o = 0; o < kOpponents; ++o) {
+          if (seat_values[o + 1] > max_opponent) {
+            max_opponent = seat_values[o + 1];
+            max_opp_idx = o;
+          }
         }
+        classes.record(hand_class_of(dealt[d][max_opp_idx][0], dealt[d][max_opp_idx][1]),
+                       seat_values[0], max_opponent);
+      }
+    }
+  }
+
+  using Evaluator = std::remove_cvref_t<decltype(evaluator<kEvaluator>())>;
+  if constexpr (IncrementalEvaluator<Evaluator>) {
+    if (!task.ranks) {
+      // Incremental Path: the known board, and the hole cards on top of
+      // it, are folded into evaluator states once per chunk. A simulation
+      // adds the dealt board cards to both, and each opponent only its two
+      // hole cards to the finished board. Same values as the scalar path.
+      const Evaluator& eval = evaluator<kEvaluator>();
+      typename Evaluator::State known{};
+      for (const Card& card : task.board) known = eval.add(known, card_id(card));
+      typename Evaluator::State hero_known = known;
+      for (const Card& card : task.hole_cards) hero_known = eval.add(hero_known, card_id(card));
 
-        std::vector<std::vector<Card>> opponent_hands;
-        for (int i = 0; i < request.num_opponents; ++i) {
-          opponent_hands.push_back(deck.sample(2));
+      for (; sim_num < chunk_sims; ++sim_num) {
+        deck.reset();
+        deck.sample_into(board_cards.data() + known_board, remaining_board);
+        for (auto& opp_hand : opponent_hands) {
+          deck.sample_into(opp_hand.data(), 2);
         }
 
-        int32_t our_value =
-            evaluate_with_algorithm(request.algorithm, hole_cards, board_cards);
+        typename Evaluator::State board = known;
+        typename Evaluator::State hero = hero_known;
+        for (size_t i = known_board; i < 5; ++i) {
+          const uint8_t id = card_id(board_cards[i]);
+          board = eval.add(board, id);
+          hero = eval.add(hero, id);
+        }
+        const int32_t our_value = eval.evaluate(hero);
 
         int32_t max_opponent = 0;
-        size_t max_opp_idx = 0;
-        for (size_t i = 0; i < opponent_hands.size(); ++i) {
-          int32_t val = evaluate_with_algorithm(request.algorithm,
-                                                 opponent_hands[i], board_cards);
+        int max_opp_idx = 0;
+        for (int i = 0; i < kOpponents; ++i) {
+          const int32_t val = eval.evaluate(eval.add(eval.add(board, card_id(opponent_hands[i][0])),
+                                                     card_id(opponent_hands[i][1])));
           if (val > max_opponent) {
             max_opponent = val;
             max_opp_idx = i;
           }
         }
 
-        std::string opp_class =
-            opponent_hands.empty()
-                ? "??"
-                : naive_evaluator_.classify_hole_cards(opponent_hands[max_opp_idx]);
-
-        if (local_opponent_stats.find(opp_class) == local_opponent_stats.end()) {
-          local_opponent_stats[opp_class] = EquityResult();
-          local_opponent_stats[opp_class].hand_name = opp_class;
+        int opp_class = HandAccumulator::kNoOpponent;
+        if constexpr (kOpponents > 0) {
+          opp_class = hand_class_of(opponent_hands[max_opp_idx][0], opponent_hands[max_opp_idx][1]);
         }
+        classes.record(opp_class, our_value, max_opponent);
+      }
+    }
+  }
 
-        EquityResult& stats = local_opponent_stats[opp_class];
-        stats.total_simulations++;
+  // Scalar Path (and the tail of a chunk on the batch paths)
+  for (; sim_num < chunk_sims; ++sim_num) {
+    deck.reset();
+    deck.sample_into(board_cards.data() + known_board, remaining_board);
+    for (auto& opp_hand : opponent_hands) {
+      deck.sample_into(opp_hand.data(), 2);
+    }
 
-        if (our_value > max_opponent) {
-          stats.wins++;
-          stats.win_method_matrix[get_hand_type(our_value)]
-                                 [get_hand_type(max_opponent)]++;
-        } else if (our_value == max_opponent) {
-          stats.ties++;
-        } else {
-          stats.losses++;
-          stats.loss_method_matrix[get_hand_type(max_opponent)]
-                                  [get_hand_type(our_value)]++;
-        }
+    // Hole cards in slots 0-1, the shared board in 2-6
+    uint8_t hand_ids[kMaxHandCards];
+    for (int i = 0; i < 5; ++i) hand_ids[i + 2] = card_id(board_cards[i]);
+    const CardIds hand(hand_ids, kMaxHandCards);
+
+    const int32_t* board_ranks = task.ranks ? task.ranks->find(hand_ids + 2) : nullptr;
+
+    hand_ids[0] = card_id(task.hole_cards[0]);
+    hand_ids[1] = card_id(task.hole_cards[1]);
+    int32_t our_value = showdown_value<kEvaluator>(board_ranks, hand);
 
-        sim_num++;
-        simulations_processed_++;
+    int32_t max_opponent = 0;
+    int max_opp_idx = 0;
+    for (int i = 0; i < kOpponents; ++i) {
+      hand_ids[0] = card_id(opponent_hands[i][0]);
+      hand_ids[1] = card_id(opponent_hands[i][1]);
+      int32_t val = showdown_value<kEvaluator>(board_ranks, hand);
+      if (val > max_opponent) {
+        max_opponent = val;
+        max_opp_idx = i;
       }
+    }
 
-      if (shm_writer_ && (sim_num % update_interval == 0)) {
-        std::lock_guard<std::mutex> lock(results_mutex);
-        uint64_t current_processed = simulations_processed_.load();
-        if ((current_processed - last_update_count_) >= update_frequency_) {
-          shm_writer_->update_hands(current_processed);
-          last_update_count_ = current_processed;
-        }
+    int opp_class = HandAccumulator::kNoOpponent;
+    if constexpr (kOpponents > 0) {
+      opp_class = hand_class_of(opponent_hands[max_opp_idx][0], opponent_hands[max_opp_idx][1]);
+    }
+    classes.record(opp_class, our_value, max_opponent);
+  }
+}
 
-        for (auto& pair : local_opponent_stats) {
-          const std::string& name = pair.first;
-          const EquityResult& local_stats = pair.second;
-          if (results.find(name) == results.end()) {
-            results[name] = local_stats;
-          } else {
-            results[name].wins += local_stats.wins;
-            results[name].ties += local_stats.ties;
-            results[name].losses += local_stats.losses;
-            results[name].total_simulations += local_stats.total_simulations;
-          }
-          uint32_t total = results[name].total_simulations;
-          if (total > 0) {
-            results[name].equity =
-                (results[name].wins + results[name].ties * 0.5) / total;
-          }
-        }
-        shm_writer_->update_equity_results(results);
+template <EvaluatorType kEvaluator, int kOpponents>
+void EquityEngine::run_weighted_chunk(const HandTask& task, int chunk, HandAccumulator& classes) {
+  // Same dead cards and per-chunk stream as run_chunk; the seats' draws
+  // come from the deck's stream too
+  Deck deck(task.seed, task.hand_stream | static_cast<uint32_t>(chunk));
+  std::vector<Card> dead_cards = task.hole_cards;
+  dead_cards.insert(dead_cards.end(), task.board.begin(), task.board.end());
+  deck.set_dead_cards(dead_cards);
+
+  const size_t known_board = task.board.size();
+  const int remaining_board = 5 - static_cast<int>(known_board);
+  std::array<Card, 5> board_cards;
+  std::copy(task.board.begin(), task.board.end(), board_cards.begin());
+  std::array<std::array<uint8_t, 2>, kOpponents> opponent_hands;
+
+  const int chunk_sims = std::min(kSimulationsPerChunk,
+                                  task.simulations - chunk * kSimulationsPerChunk);
+
+  // Hole cards in slots 0-1, the board in 2-6
+  uint8_t hand_ids[kMaxHandCards];
+  const CardIds hand(hand_ids, kMaxHandCards);
+  for (int sim_num = 0; sim_num < chunk_sims; ++sim_num) {
+    deck.reset();
+    // Seats in order, each clear of the ones before it; their cards leave
+    // the deck before the board is dealt
+    uint64_t dealt = 0;
+    for (int o = 0; o < kOpponents; ++o) {
+      const SeatRange& seat = task.seats[std::min<size_t>(o, task.seats.size() - 1)];
+      opponent_hands[o] = seat.draw(deck, dealt);
+      for (uint8_t id : opponent_hands[o]) {
+        dealt |= uint64_t{1} << id;
+        deck.remove(card_from_id(id));
       }
     }
+    deck.sample_into(board_cards.data() + known_board, remaining_board);
+    for (int i = 0; i < 5; ++i) hand_ids[i + 2] = card_id(board_cards[i]);
 
-    std::lock_guard<std::mutex> lock(results_mutex);
-    for (auto& pair : local_opponent_stats) {
-      const std::string& name = pair.first;
-      const EquityResult& local_stats = pair.second;
-      if (results.find(name) == results.end()) {
-        results[name] = local_stats;
-      } else {
-        results[name].wins += local_stats.wins;
-        results[name].ties += local_stats.ties;
-        results[name].losses += local_stats.losses;
-        results[name].total_simulations += local_stats.total_simulations;
-        for (int i = 0; i < 10; ++i) {
-          for (int j = 0; j < 10; ++j) {
-            results[name].win_method_matrix[i][j] +=
-                local_stats.win_method_matrix[i][j];
-            results[name].loss_method_matrix[i][j] +=
-                local_stats.loss_method_matrix[i][j];
-          }
-        }
+    const int32_t* board_ranks = task.ranks ? task.ranks->find(hand_ids + 2) : nullptr;
+
+    hand_ids[0] = card_id(task.hole_cards[0]);
+    hand_ids[1] = card_id(task.hole_cards[1]);
+    const int32_t our_value = showdown_value<kEvaluator>(board_ranks, hand);
+
+    int32_t max_opponent = 0;
+    int max_opp_idx = 0;
+    for (int o = 0; o < kOpponents; ++o) {
+      hand_ids[0] = opponent_hands[o][0];
+      hand_ids[1] = opponent_hands[o][1];
+      const int32_t value = showdown_value<kEvaluator>(board_ranks, hand);
+      if (value > max_opponent) {
+        max_opponent = value;
+        max_opp_idx = o;
+      }
+    }
+
+    int opp_class = HandAccumulator::kNoOpponent;
+    if constexpr (kOpponents > 0) {
+      opp_class = hand_class_of(opponent_hands[max_opp_idx][0], opponent_hands[max_opp_idx][1]);
+    }
+    classes.record(opp_class, our_value, max_opponent);
+  }
+}
+
+template <EvaluatorType kEvaluator, int kOpponents>
+void EquityEngine::run_enumeration_chunk(const HandTask& task, int chunk,
+                                         HandAccumulator& classes) {
+  uint64_t live_mask = (1ULL << 52) - 1;
+  for (const Card& card : task.hole_cards) live_mask &= ~(1ULL << card_id(card));
+  for (const Card& card : task.board) live_mask &= ~(1ULL << card_id(card));
+
+  const int known_board = static_cast<int>(task.board.size());
+  RunoutEnumerator deals(live_mask, 5 - known_board, kOpponents);
+  deals.seek(static_cast<uint64_t>(chunk) * kSimulationsPerChunk);
+  const int chunk_sims = std::min(kSimulationsPerChunk,
+                                  task.simulations - chunk * kSimulationsPerChunk);
+
+  // Hole cards in slots 0-1, the board in 2-6
+  uint8_t hand_ids[kMaxHandCards];
+  for (int i = 0; i < known_board; ++i) hand_ids[i + 2] = card_id(task.board[i]);
+  const CardIds hand(hand_ids, kMaxHandCards);
+
+  // Values of the hero (level 0, the board) and each opponent (level o + 1)
+  // are kept until a level they depend on changes: on the river against
+  // one opponent the hero is evaluated once per chunk
+  int32_t our_value = 0;
+  std::array<int32_t, kOpponents> opponent_values{};
+  const int32_t* board_ranks = nullptr;
+  int changed = 0;
+  for (int sim_num = 0; sim_num < chunk_sims; ++sim_num) {
+    if (changed == 0) {
+      for (int i = known_board; i < 5; ++i) hand_ids[i + 2] = deals.card(0, i - known_board);
+      if (task.ranks) board_ranks = task.ranks->find(hand_ids + 2);
+      hand_ids[0] = card_id(task.hole_cards[0]);
+      hand_ids[1] = card_id(task.hole_cards[1]);
+      our_value = showdown_value<kEvaluator>(board_ranks, hand);
+    }
+    for (int o = std::max(changed, 1) - 1; o < kOpponents; ++o) {
+      hand_ids[0] = deals.card(o + 1, 0);
+      hand_ids[1] = deals.card(o + 1, 1);
+      opponent_values[o] = showdown_value<kEvaluator>(board_ranks, hand);
+    }
+
+    int32_t max_opponent = 0;
+    int max_opp_idx = 0;
+    for (int o = 0; o < kOpponents; ++o) {
+      if (opponent_values[o] > max_opponent) {
+        max_opponent = opponent_values[o];
+        max_opp_idx = o;
+      }
+    }
+
+    int opp_class = HandAccumulator::kNoOpponent;
+    if constexpr (kOpponents > 0) {
+      opp_class = hand_class_of(deals.card(max_opp_idx + 1, 0), deals.card(max_opp_idx + 1, 1));
+    }
+    classes.record(opp_class, our_value, max_opponent);
+
+    changed = deals.next();
+  }
+}
+
+bool EquityEngine::plan_round(RangeJob& job) {
+  std::vector<int> targets;
+  if (job.target_std_error) {
+    for (const auto& hand : job.hands) targets.push_back(precision_chunk_target(job, *hand));
+  } else if (job.schedule == Schedule::NEYMAN) {
+    targets = neyman_chunk_targets(job);
+  } else if (job.schedule == Schedule::PROGRESSIVE) {
+    // One chunk each, then double
+    const int doubled = job.round < 30 ? 1 << job.round : INT_MAX;
+    for (const auto& hand : job.hands) targets.push_back(std::min(doubled, hand->max_chunks));
+  } else {
+    for (const auto& hand : job.hands) targets.push_back(hand->max_chunks);
+  }
+  const bool final_round = job.schedule == Schedule::NEYMAN && job.round == kNeymanRounds;
+
+  bool planned = false;
+  for (size_t i = 0; i < job.hands.size(); ++i) {
+    HandTask& hand = *job.hands[i];
+    if (hand.finished) continue;
+    if (targets[i] <= hand.chunks_issued) {
+      finish_hand(job, hand);
+      continue;
+    }
+    hand.round_first = hand.chunks_issued;
+    hand.chunks_issued = targets[i];
+    hand.last_round = final_round || targets[i] == hand.max_chunks;
+    hand.chunks_left = targets[i] - hand.round_first;
+    planned = true;
+  }
+  job.round++;
+  return planned;
+}
+
+int EquityEngine::precision_chunk_target(const RangeJob& job, const HandTask& hand) const {
+  if (hand.finished) return hand.chunks_issued;
+  if (hand.chunks_issued == 0) return std::min(kPrecisionFirstChunks, hand.max_chunks);
+
+  // Every issued chunk has merged. Stop at the target, or else jump to the
+  // simulations the observed variance says it needs, growing by at most
+  // kPrecisionMaxGrowth so an early, noisy estimate cannot overshoot far.
+  const OutcomeCounts& counts = hand.counts;
+  const double std_error = equity_std_error(counts.wins, counts.ties, counts.total);
+  const double target = *job.target_std_error;
+  if (std_error <= target) return hand.chunks_issued;
+
+  const double needed = counts.total * (std_error / target) * (std_error / target);
+  const double needed_chunks = std::ceil(needed / kSimulationsPerChunk);
+  const int grown = static_cast<int>(std::min<double>(
+      needed_chunks, static_cast<double>(hand.chunks_issued) * kPrecisionMaxGrowth));
+  return std::min(hand.max_chunks, std::max(hand.chunks_issued + 1, grown));
+}
+
+std::vector<int> EquityEngine::neyman_chunk_targets(const RangeJob& job) const {
+  const int num_hands = static_cast<int>(job.hands.size());
+  std::vector<int> targets(num_hands);
+
+  // Pilot: the same few chunks for every hand, to measure its variance
+  const int pilot = std::clamp(job.budget_chunks / (4 * num_hands), 1, kNeymanPilotChunks);
+  if (job.round == 0) {
+    for (int i = 0; i < num_hands; ++i) targets[i] = std::min(pilot, job.hands[i]->max_chunks);
+    return targets;
+  }
+
+  // Round r brings the job's total to its share r / kNeymanRounds of what
+  // the pilot left. Each hand should hold chunks in proportion to its
+  // payoff variance, which evens out the hands' standard errors; hands
+  // already past their share get nothing and the round's chunks are split
+  // over the others' shortfalls (largest remainder, so the sum is exact).
+  int issued = 0;
+  int pilot_total = 0;
+  std::vector<double> variances(num_hands);
+  double total_variance = 0.0;
+  for (int i = 0; i < num_hands; ++i) {
+    const HandTask& hand = *job.hands[i];
+    issued += hand.chunks_issued;
+    pilot_total += std::min(pilot, hand.max_chunks);
+    const OutcomeCounts& counts = hand.counts;
+    // A floor keeps a hand that has not lost yet from being starved
+    variances[i] = std::max(equity_variance(counts.wins, counts.ties, counts.total), 1e-4);
+    total_variance += variances[i];
+    targets[i] = hand.chunks_issued;
+  }
+
+  const int job_target = pilot_total + (job.budget_chunks - pilot_total) *
+                                          std::min(job.round, kNeymanRounds) / kNeymanRounds;
+  const int round_chunks = job_target - issued;
+  if (round_chunks <= 0) return targets;
+
+  std::vector<double> shortfalls(num_hands);
+  double total_shortfall = 0.0;
+  for (int i = 0; i < num_hands; ++i) {
+    const double share = job_target * variances[i] / total_variance;
+    shortfalls[i] = std::max(0.0, share - job.hands[i]->chunks_issued);
+    total_shortfall += shortfalls[i];
+  }
+  if (total_shortfall <= 0.0) return targets;
+
+  std::vector<std::pair<double, int>> remainders;
+  int assigned = 0;
+  for (int i = 0; i < num_hands; ++i) {
+    const double exact = round_chunks * shortfalls[i] / total_shortfall;
+    const int whole = static_cast<int>(exact);
+    targets[i] += whole;
+    assigned += whole;
+    remainders.emplace_back(exact - whole, i);
+  }
+  // Ties go to the earlier hand, so the split is deterministic
+  std::stable_sort(remainders.begin(), remainders.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+  for (int k = 0; k < round_chunks - assigned; ++k) targets[remainders[k].second]++;
+
+  for (int i = 0; i < num_hands; ++i) targets[i] = std::min(targets[i], job.hands[i]->max_chunks);
+  return targets;
+}
+
+void EquityEngine::run_round(RangeJob& job, bool parallel,
+                             std::unordered_map<std::string, EquityResult>& results) {
+  // In parallel every (hand, chunk) pair is a task on the shared pool and
+  // this thread reports until they are all done. Otherwise the chunks run
+  // here, hand by hand.
+  if (parallel) {
+    TaskGroup group(ThreadPool::instance());
+    for (auto& hand : job.hands) {
+      if (hand->finished) continue;
+      for (int chunk = hand->round_first; chunk < hand->chunks_issued; ++chunk) {
+        group.run([this, &job, task = hand.get(), chunk] { run_hand_chunk(job, *task, chunk); });
       }
-      uint32_t total = results[name].total_simulations;
-      if (total > 0) {
-        results[name].equity =
-            (results[name].wins + results[name].ties * 0.5) / total;
+    }
+    while (!group.wait_for(kReportInterval)) {
+      report_progress(job, results);
+    }
+    report_progress(job, results);
+  } else {
+    for (auto& hand : job.hands) {
+      if (hand->finished) continue;
+      for (int chunk = hand->round_first; chunk < hand->chunks_issued; ++chunk) {
+        run_hand_chunk(job, *hand, chunk);
       }
+      report_progress(job, results);
     }
+  }
+}
+
+template <EvaluatorType kEvaluator, int kOpponents>
+void EquityEngine::run_board_chunk(RangeJob& job, int chunk) {
+  // One shared deal: the completed board, the cards it and the opponents
+  // use, and the strongest opponent
+  struct SharedDeal {
+    std::array<uint8_t, 5> board;
+    const int32_t* ranks;  // the board's rank vector, under BOARD_CACHE
+    uint64_t used;
+    int32_t max_opponent;
+    uint8_t opp_class;
   };
+  thread_local std::array<SharedDeal, kSimulationsPerChunk> deals;
+
+  Deck deck(job.seed, kSharedBoardStream | static_cast<uint32_t>(chunk));
+  deck.set_dead_cards(*job.board);
+  const size_t known_board = job.board->size();
+  const int remaining_board = 5 - static_cast<int>(known_board);
+  std::array<Card, 5> board_cards;
+  std::copy(job.board->begin(), job.board->end(), board_cards.begin());
+  std::array<std::array<Card, 2>, kOpponents> opponent_hands;
+
+  const int chunk_deals = std::min(kSimulationsPerChunk,
+                                   job.board_deals - chunk * kSimulationsPerChunk);
+
+  uint8_t hand_ids[kMaxHandCards];
+  const CardIds hand(hand_ids, kMaxHandCards);
+  for (int d = 0; d < chunk_deals; ++d) {
+    deck.reset();
+    deck.sample_into(board_cards.data() + known_board, remaining_board);
+    for (auto& opp_hand : opponent_hands) {
+      deck.sample_into(opp_hand.data(), 2);
+    }
+
+    SharedDeal& deal = deals[d];
+    deal.used = 0;
+    for (int i = 0; i < 5; ++i) {
+      deal.board[i] = card_id(board_cards[i]);
+      hand_ids[i + 2] = deal.board[i];
+      if (i >= static_cast<int>(known_board)) deal.used |= 1ULL << deal.board[i];
+    }
+    deal.ranks = job.ranks ? job.ranks->find(deal.board.data()) : nullptr;
 
-  std::vector<std::thread> threads;
-  int sims_per_thread = simulations_per_hand / num_workers;
-  for (int i = 0; i < num_workers - 1; ++i) {
-    threads.emplace_back(run_worker, sims_per_thread);
+    deal.max_opponent = 0;
+    int max_opp_idx = 0;
+    for (int o = 0; o < kOpponents; ++o) {
+      hand_ids[0] = card_id(opponent_hands[o][0]);
+      hand_ids[1] = card_id(opponent_hands[o][1]);
+      deal.used |= (1ULL << hand_ids[0]) | (1ULL << hand_ids[1]);
+      const int32_t value = showdown_value<kEvaluator>(deal.ranks, hand);
+      if (value > deal.max_opponent) {
+        deal.max_opponent = value;
+        max_opp_idx = o;
+      }
+    }
+    deal.opp_class = HandAccumulator::kNoOpponent;
+    if constexpr (kOpponents > 0) {
+      deal.opp_class = static_cast<uint8_t>(
+          hand_class_of(opponent_hands[max_opp_idx][0], opponent_hands[max_opp_idx][1]));
+    }
   }
-  run_worker(simulations_per_hand - (sims_per_thread * (num_workers - 1)));
 
-  for (auto& t : threads) t.join();
+  // Score every hero hand on the deals its cards are free in: given that,
+  // a deal is uniform over the cards the hand leaves, as if dealt for it.
+  // Chunks start at different hands so threads rarely wait on one lock.
+  uint64_t recorded = 0;
+  std::unique_lock<std::mutex> classes_lock;
+  HandAccumulator& classes = job.thread_classes(classes_lock);
+  const size_t num_hands = job.hands.size();
+  for (size_t k = 0; k < num_hands; ++k) {
+    HandTask& task = *job.hands[(chunk + k) % num_hands];
+    const uint8_t hero0 = card_id(task.hole_cards[0]);
+    const uint8_t hero1 = card_id(task.hole_cards[1]);
+    const uint64_t hero_mask = (1ULL << hero0) | (1ULL << hero1);
+    hand_ids[0] = hero0;
+    hand_ids[1] = hero1;
+
+    // Board-major hands are never grouped, so each counts its deals once
+    std::lock_guard<std::mutex> lock(task.mutex);
+    for (int d = 0; d < chunk_deals; ++d) {
+      const SharedDeal& deal = deals[d];
+      if (deal.used & hero_mask) continue;
+      std::copy(deal.board.begin(), deal.board.end(), hand_ids + 2);
+      const int32_t value = showdown_value<kEvaluator>(deal.ranks, hand);
+      task.counts.record(value, deal.max_opponent);
+      classes.record(deal.opp_class, value, deal.max_opponent);
+      recorded++;
+    }
+  }
+
+  job.counters[job.thread_slot()].value.fetch_add(recorded, std::memory_order_relaxed);
+}
+
+void EquityEngine::run_board_major(RangeJob& job, bool parallel,
+                                   std::unordered_map<std::string, EquityResult>& results) {
+  const int num_chunks = (job.board_deals + kSimulationsPerChunk - 1) / kSimulationsPerChunk;
+  if (parallel) {
+    TaskGroup group(ThreadPool::instance());
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+      group.run([this, &job, chunk] { (this->*job.board_kernel)(job, chunk); });
+    }
+    while (!group.wait_for(kReportInterval)) {
+      report_progress(job, results);
+    }
+  } else {
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+      (this->*job.board_kernel)(job, chunk);
+      report_progress(job, results);
+    }
+  }
+
+  for (auto& hand : job.hands) {
+    if (!hand->finished) finish_hand(job, *hand);
+  }
+}
+
+void EquityEngine::run_hand_chunk(RangeJob& job, HandTask& hand, int chunk) {
+  HandAccumulator& scratch = chunk_scratch();
+  (this->*job.kernel)(hand, chunk, scratch);
+  job.merge(hand, scratch);
+
+  const int chunk_sims =
+      std::min(kSimulationsPerChunk, hand.simulations - chunk * kSimulationsPerChunk);
+  job.counters[job.thread_slot()].value.fetch_add(chunk_sims, std::memory_order_relaxed);
+
+  if (hand.chunks_left.fetch_sub(1, std::memory_order_acq_rel) == 1 && hand.last_round) {
+    finish_hand(job, hand);
+  }
+}
 
+void EquityEngine::finish_hand(RangeJob& job, HandTask& hand) {
+  // Every chunk is merged, so hand.counts is no longer written
   EquityResult overall;
-  overall.hand_name = hand_name;
-  uint32_t total_sims = 0, total_wins = 0, total_ties = 0, total_losses = 0;
-
-  for (const auto& pair : results) {
-    const EquityResult& stats_ref = pair.second;
-    total_sims += stats_ref.total_simulations;
-    total_wins += stats_ref.wins;
-    total_ties += stats_ref.ties;
-    total_losses += stats_ref.losses;
-    for (int i = 0; i < 10; ++i) {
-      for (int j = 0; j < 10; ++j) {
-        overall.win_method_matrix[i][j] += stats_ref.win_method_matrix[i][j];
-        overall.loss_method_matrix[i][j] += stats_ref.loss_method_matrix[i][j];
-      }
+  overall.hand_name = hand.name;
+  add_to_result(hand.counts, overall);
+  if (job.exact) overall.std_error = 0.0;
+
+  std::lock_guard<std::mutex> lock(job.mutex);
+  for (const std::string& member : hand.members) {
+    overall.hand_name = member;
+    job.hand_results[member] = overall;
+  }
+  hand.finished = true;
+  job.hands_finished++;
+}
+
+void EquityEngine::report_progress(RangeJob& job,
+                                   std::unordered_map<std::string, EquityResult>& results) {
+  size_t hands_finished;
+  {
+    std::lock_guard<std::mutex> lock(job.mutex);
+    hands_finished = job.hands_finished;
+  }
+  // A round that has fully merged is news too: under PROGRESSIVE no hand
+  // finishes before the last one
+  const bool hands_changed =
+      hands_finished != job.hands_reported || job.round != job.rounds_reported;
+  job.hands_reported = hands_finished;
+  job.rounds_reported = job.round;
+
+  if (!shm_writer_ && !(progress_callback_ && hands_changed)) return;
+  publish_results(job, true, results);
+
+  uint64_t processed = 0;
+  for (const auto& counter : job.counters) {
+    processed += counter.value.load(std::memory_order_relaxed);
+  }
+
+  if (shm_writer_) {
+    shm_writer_->update_hands(processed);
+    shm_writer_->update_equity_results(results);
+
+    // Pool utilization since the previous report: busy time over
+    // threads x wall time
+    const auto now = std::chrono::steady_clock::now();
+    const ThreadPool::Stats stats = ThreadPool::instance().stats();
+    const double wall_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - job.last_report).count());
+    const double busy_ns = static_cast<double>(stats.busy_ns - job.last_pool_stats.busy_ns);
+    const double utilization =
+        wall_ns > 0 ? std::min(1.0, busy_ns / (wall_ns * stats.threads)) : 0.0;
+    shm_writer_->update_pool(stats.threads, static_cast<float>(utilization), stats.queued,
+                             stats.tasks_completed, stats.tasks_stolen);
+    job.last_pool_stats = stats;
+    job.last_report = now;
+  }
+
+  if (progress_callback_ && hands_changed) {
+    std::unordered_map<std::string, double> current_results;
+    for (const auto& pair : results) {
+      current_results[pair.first] = pair.second.equity;
+    }
+    double progress = static_cast<double>(hands_finished) / job.hands.size();
+    if (job.planned_simulations > 0) {
+      progress = std::max(progress, std::min(1.0, static_cast<double>(processed) /
+                                                      job.planned_simulations));
     }
+    progress_callback_(progress, current_results);
   }
+}
+
+// Table of run_chunk instantiations for one evaluator, indexed by
+// num_opponents
+template <EvaluatorType kEvaluator, bool kBatch>
+EquityEngine::WorkerFn EquityEngine::worker_for(int num_opponents) {
+  static constexpr auto kWorkers =
+      []<int... kOpponents>(std::integer_sequence<int, kOpponents...>) {
+        return std::array<WorkerFn, sizeof...(kOpponents)>{
+            &EquityEngine::run_chunk<kEvaluator, kBatch && (kOpponents > 0), kOpponents>...};
+      }(std::make_integer_sequence<int, kMaxOpponents + 1>{});
+  return kWorkers[num_opponents];
+}
+
+template <EvaluatorType kEvaluator>
+EquityEngine::WorkerFn EquityEngine::enumerator_for(int num_opponents) {
+  static constexpr auto kWorkers =
+      []<int... kOpponents>(std::integer_sequence<int, kOpponents...>) {
+        return std::array<WorkerFn, sizeof...(kOpponents)>{
+            &EquityEngine::run_enumeration_chunk<kEvaluator, kOpponents>...};
+      }(std::make_integer_sequence<int, kMaxOpponents + 1>{});
+  return kWorkers[num_opponents];
+}
+
+template <EvaluatorType kEvaluator>
+EquityEngine::WorkerFn EquityEngine::weighted_worker_for(int num_opponents) {
+  static constexpr auto kWorkers =
+      []<int... kOpponents>(std::integer_sequence<int, kOpponents...>) {
+        return std::array<WorkerFn, sizeof...(kOpponents)>{
+            &EquityEngine::run_weighted_chunk<kEvaluator, kOpponents>...};
+      }(std::make_integer_sequence<int, kMaxOpponents + 1>{});
+  return kWorkers[num_opponents];
+}
 
-  overall.total_simulations = total_sims;
-  overall.wins = total_wins;
-  overall.ties = total_ties;
-  overall.losses = total_losses;
-  if (total_sims > 0) {
-    overall.equity =
-        static_cast<double>(total_wins + total_ties * 0.5) / total_sims;
+template <EvaluatorType kEvaluator>
+EquityEngine::BoardWorkerFn EquityEngine::board_worker_for(int num_opponents) {
+  static constexpr auto kWorkers =
+      []<int... kOpponents>(std::integer_sequence<int, kOpponents...>) {
+        return std::array<BoardWorkerFn, sizeof...(kOpponents)>{
+            &EquityEngine::run_board_chunk<kEvaluator, kOpponents>...};
+      }(std::make_integer_sequence<int, kMaxOpponents + 1>{});
+  return kWorkers[num_opponents];
+}
+
+EquityEngine::BoardWorkerFn EquityEngine::select_board_worker(EvaluatorType evaluator,
+                                                              int num_opponents) {
+  check_num_opponents(num_opponents);
+  switch (evaluator) {
+    case EvaluatorType::CACTUS_KEV:
+      return board_worker_for<EvaluatorType::CACTUS_KEV>(num_opponents);
+    case EvaluatorType::PH_EVALUATOR:
+      return board_worker_for<EvaluatorType::PH_EVALUATOR>(num_opponents);
+    case EvaluatorType::TWO_PLUS_TWO:
+      return board_worker_for<EvaluatorType::TWO_PLUS_TWO>(num_opponents);
+    case EvaluatorType::OMP_EVAL:
+      return board_worker_for<EvaluatorType::OMP_EVAL>(num_opponents);
+    case EvaluatorType::NAIVE:
+      break;
+  }
+  return board_worker_for<EvaluatorType::NAIVE>(num_opponents);
+}
+
+EquityEngine::WorkerFn EquityEngine::select_worker(EvaluatorType evaluator,
+                                                   uint8_t optimization_flags,
+                                                   int num_opponents,
+                                                   bool opponent_ranges) {
+  check_num_opponents(num_opponents);
+
+  // Weighted ranges deal each seat from its own table, one deal at a time
+  if (opponent_ranges) {
+    switch (evaluator) {
+      case EvaluatorType::CACTUS_KEV:
+        return weighted_worker_for<EvaluatorType::CACTUS_KEV>(num_opponents);
+      case EvaluatorType::PH_EVALUATOR:
+        return weighted_worker_for<EvaluatorType::PH_EVALUATOR>(num_opponents);
+      case EvaluatorType::TWO_PLUS_TWO:
+        return weighted_worker_for<EvaluatorType::TWO_PLUS_TWO>(num_opponents);
+      case EvaluatorType::OMP_EVAL:
+        return weighted_worker_for<EvaluatorType::OMP_EVAL>(num_opponents);
+      case EvaluatorType::NAIVE:
+        break;
+    }
+    return weighted_worker_for<EvaluatorType::NAIVE>(num_opponents);
+  }
+
+  // Enumeration evaluates about one hand per deal, so it has no SIMD path
+  if (optimization_flags & EXHAUSTIVE) {
+    switch (evaluator) {
+      case EvaluatorType::CACTUS_KEV:
+        return enumerator_for<EvaluatorType::CACTUS_KEV>(num_opponents);
+      case EvaluatorType::PH_EVALUATOR:
+        return enumerator_for<EvaluatorType::PH_EVALUATOR>(num_opponents);
+      case EvaluatorType::TWO_PLUS_TWO:
+        return enumerator_for<EvaluatorType::TWO_PLUS_TWO>(num_opponents);
+      case EvaluatorType::OMP_EVAL:
+        return enumerator_for<EvaluatorType::OMP_EVAL>(num_opponents);
+      case EvaluatorType::NAIVE:
+        break;
+    }
+    return enumerator_for<EvaluatorType::NAIVE>(num_opponents);
   }
 
-  return overall;
+  switch (evaluator) {
+    case EvaluatorType::CACTUS_KEV:
+      return worker_for<EvaluatorType::CACTUS_KEV, false>(num_opponents);
+    case EvaluatorType::PH_EVALUATOR:
+      return worker_for<EvaluatorType::PH_EVALUATOR, false>(num_opponents);
+    case EvaluatorType::TWO_PLUS_TWO:
+      // PREFETCHING interleaves Two Plus Two's table walks; the other
+      // evaluators have no chain of misses to overlap
+      if (optimization_flags & PREFETCHING) {
+        return worker_for<EvaluatorType::TWO_PLUS_TWO, true>(num_opponents);
+      }
+      return worker_for<EvaluatorType::TWO_PLUS_TWO, false>(num_opponents);
+    case EvaluatorType::OMP_EVAL:
+      // SIMD only changes anything for OMPEval, the one SIMD evaluator
+      if (optimization_flags & SIMD) {
+        return worker_for<EvaluatorType::OMP_EVAL, true>(num_opponents);
+      }
+      return worker_for<EvaluatorType::OMP_EVAL, false>(num_opponents);
+    case EvaluatorType::NAIVE:
+      break;
+  }
+  return worker_for<EvaluatorType::NAIVE, false>(num_opponents);
 }
 
-int32_t EquityEngine::evaluate_with_algorithm(const std::string& algorithm,
-                                               const std::vector<Card>& hole,
-                                               const std::vector<Card>& board) const {
-    // Support both lowercase and uppercase enum values from frontend
-    std::string algo_lower = algorithm;
-    std::transform(algo_lower.begin(), algo_lower.end(), algo_lower.begin(), ::tolower);
+void EquityEngine::publish_results(
+    RangeJob& job, bool include_running,
+    std::unordered_map<std::string, EquityResult>& results) const {
+  results.clear();
+  auto add_classes = [&results, exact = job.exact](const HandAccumulator& classes) {
+    for (int slot = 0; slot < HandAccumulator::kSlots; ++slot) {
+      if (classes[slot].total == 0) continue;
+      const std::string name = HandAccumulator::slot_name(slot);
+      EquityResult& result = results[name];
+      result.hand_name = name;
+      add_to_result(classes[slot], result);
+      if (exact) result.std_error = 0.0;
+    }
+  };
+
+  // The shards hold every merged chunk, of running hands too
+  for (ClassShard& shard : job.class_shards) {
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    if (shard.classes) add_classes(*shard.classes);
+  }
 
-    if (algo_lower == "cactus_kev") return cactus_kev_evaluator_.evaluate_hand(hole, board);
-    if (algo_lower == "ph_evaluator" || algo_lower == "perfect_hash") return ph_evaluator_.evaluate_hand(hole, board);
-    if (algo_lower == "two_plus_two") return tpt_evaluator_.evaluate_hand(hole, board);
-    if (algo_lower == "omp_eval" || algo_lower == "omp") return omp_evaluator_.evaluate_hand(hole, board);
-    if (algo_lower == "naive") return naive_evaluator_.evaluate_hand(hole, board);
+  std::lock_guard<std::mutex> lock(job.mutex);
+  std::vector<EquityResult> running;
+  if (include_running) {
+    for (auto& hand : job.hands) {
+      if (hand->finished) continue;
+      std::lock_guard<std::mutex> hand_lock(hand->mutex);
+      if (hand->counts.total == 0) continue;
+      EquityResult overall;
+      add_to_result(hand->counts, overall);
+      for (const std::string& member : hand->members) {
+        overall.hand_name = member;
+        running.push_back(overall);
+      }
+    }
+  }
 
-    // Default to naive if unknown algorithm
-    return naive_evaluator_.evaluate_hand(hole, board);
+  // A hand's overall result wins over an opponent class of the same name
+  for (const auto& pair : job.hand_results) results[pair.first] = pair.second;
+  for (const auto& overall : running) results[overall.hand_name] = overall;
 }
 
 }  // namespace poker_engine
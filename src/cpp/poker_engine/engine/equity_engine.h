@@ -2,25 +2,82 @@
 #define ENGINE_EQUITY_ENGINE_H
 
 #include "core/card.h"
-#include "evaluators/naive_evaluator.h"
-#include "evaluators/cactus_kev_evaluator.h"
-#include "evaluators/ph_evaluator.h"
-#include "evaluators/two_plus_two_evaluator.h"
-#include "evaluators/omp_eval.h"
+#include "core/range_notation.h"
+#include "evaluators/hand_types.h"
+#include "board_rank_cache.h"
 #include "equity_result.h"
+#include "evaluator_registry.h"
+#include "hand_accumulator.h"
+#include "preflop_matrix.h"
+#include "river_solver.h"
 #include "shared_memory_writer.h"
+#include "thread_pool.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <functional>
 #include <memory>
 #include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace poker_engine {
 
+// How a job's simulations are spread over its hands
+enum class Schedule : uint8_t {
+    UNIFORM,  // num_simulations / hands each
+    NEYMAN,   // the same total, re-split between rounds by observed variance
+    PROGRESSIVE,  // UNIFORM's chunks, in rounds over all hands that double
+                  // each hand's total: every hand has a coarse result early
+};
+
+// "uniform", "neyman" or "progressive", any case; anything else is UNIFORM
+inline Schedule parse_schedule(std::string_view name) {
+    if (option_name_equals(name, "neyman")) return Schedule::NEYMAN;
+    if (option_name_equals(name, "progressive")) return Schedule::PROGRESSIVE;
+    return Schedule::UNIFORM;
+}
+
+// "river_grid" (the web client's "cpp_river_grid"): exact heads-up
+// equities on a complete board for the whole 13x13 grid, not a simulation
+inline bool is_river_grid_mode(std::string_view mode) {
+    return option_name_equals(mode, "river_grid") || option_name_equals(mode, "cpp_river_grid");
+}
+
+// "preflop_matrix" (the web client's "cpp_preflop_matrix"): heads-up
+// preflop equity of every hand class against every other in one job
+inline bool is_preflop_matrix_mode(std::string_view mode) {
+    return option_name_equals(mode, "preflop_matrix") ||
+           option_name_equals(mode, "cpp_preflop_matrix");
+}
+
+// One combo of a weighted range and how often it is held, on any scale
+struct WeightedCombo {
+    std::array<Card, 2> cards;
+    double weight = 1.0;
+};
+using WeightedRange = std::vector<WeightedCombo>;
+
+// A compiled range's combos at their weights
+inline WeightedRange weighted_range(const ComboRange& range) {
+    WeightedRange result;
+    result.reserve(range.combos.count());
+    range.combos.for_each([&](int combo) {
+        const auto& cards = hand_index_tables::kComboCards[combo];
+        result.push_back({{card_from_id(cards[1]), card_from_id(cards[0])}, range.weights[combo]});
+    });
+    return result;
+}
+
 // Job request (matches Python JobRequest)
 struct JobRequest {
     std::unordered_map<std::string, std::vector<Card>> range_spec;
+    // More hands in compiled range notation: each combo the board leaves
+    // joins range_spec under its combo_name ("AsKd"). Weights are ignored;
+    // every hand gets its own result.
+    std::optional<ComboRange> range;
     std::vector<Card> board;
     int num_opponents;
     int num_simulations;
@@ -28,28 +85,39 @@ struct JobRequest {
     std::string algorithm;
     std::vector<std::string> optimizations;
     int num_workers;
+    // Fixes the random streams: the same seed gives bit-identical results
+    // for any num_workers. Unset draws a fresh seed per job.
+    std::optional<uint64_t> seed;
+    // Precision mode: sample each hand in rounds until the standard error
+    // of its equity is at most this; num_simulations / hands is then only
+    // a cap. Unset samples every hand to the cap.
+    std::optional<double> target_std_error;
+    // Budget split across hands; a precision target overrides it
+    std::string schedule;
+    // Each opponent's weighted range, by seat; a single range is every
+    // seat's. Empty deals each opponent a uniformly random hand.
+    std::vector<WeightedRange> opponent_ranges;
 };
 
 class EquityEngine {
  private:
-  NaiveEvaluator naive_evaluator_;
-  CactusKevEvaluator cactus_kev_evaluator_;
-  PHEvaluator ph_evaluator_;
-  TwoPlusTwoEvaluator tpt_evaluator_;
-  OMPEval omp_evaluator_;
+  // Borrowed: the evaluators are built once per process, not per job
+  const EvaluatorRegistry& evaluators_;
 
   std::string mode_;
   std::unique_ptr<SharedMemoryWriter> shm_writer_;
-
-  std::atomic<uint64_t> simulations_processed_;
-  uint64_t update_frequency_;
-  uint64_t last_update_count_;
+  std::shared_ptr<const PreflopMatrix> preflop_matrix_;
 
   std::function<void(double, const std::unordered_map<std::string, double>&)>
       progress_callback_;
 
  public:
-  EquityEngine(const std::string& mode, const std::string& job_id = "");
+  // Largest num_opponents the simulation kernels are instantiated for
+  // (the API caps it at 9 too)
+  static constexpr int kMaxOpponents = 9;
+
+  EquityEngine(const std::string& mode, const std::string& job_id = "",
+               const EvaluatorRegistry& evaluators = EvaluatorRegistry::instance());
 
   // Set progress callback
   void set_progress_callback(
@@ -60,17 +128,122 @@ class EquityEngine {
   std::unordered_map<std::string, EquityResult> calculate_range_equity(
       const JobRequest& request);
 
+  // The whole 169x169 heads-up preflop matrix. Every random board is
+  // evaluated once for all 1326 combos and scored for every matchup it
+  // misses; num_simulations is the number of boards. Throws
+  // std::invalid_argument unless the board is empty and heads-up.
+  PreflopMatrix calculate_preflop_matrix(const JobRequest& request);
+
+  // The matrix of the last preflop_matrix job calculate_range_equity ran
+  std::shared_ptr<const PreflopMatrix> preflop_matrix() const { return preflop_matrix_; }
+
  private:
-  // Calculate equity for single hand against opponent range
-  EquityResult calculate_hand_equity(const JobRequest& request,
-                                     const std::string& hand_name,
-                                     int simulations_per_hand,
-                                     std::unordered_map<std::string, EquityResult>& results);
-
-  // Helper to evaluate a hand using the selected algorithm
-  int32_t evaluate_with_algorithm(const std::string& algorithm,
-                                  const std::vector<Card>& hole,
-                                  const std::vector<Card>& board) const;
+  // A job's state while it runs, and one hand of it (defined in the .cpp)
+  struct RangeJob;
+  struct HandTask;
+
+  // One simulation kernel per (evaluator, batch path, opponent count).
+  // Runs one chunk of a hand into `classes`.
+  using WorkerFn = void (EquityEngine::*)(const HandTask&, int chunk, HandAccumulator& classes);
+
+  // Picks the kernel instantiation for a job's parsed options (EXHAUSTIVE
+  // picks the enumerating one, opponent ranges the weighted one). Throws
+  // std::invalid_argument if num_opponents is outside 0..kMaxOpponents.
+  static WorkerFn select_worker(EvaluatorType evaluator, uint8_t optimization_flags,
+                                int num_opponents, bool opponent_ranges = false);
+
+  template <EvaluatorType kEvaluator, bool kBatch>
+  static WorkerFn worker_for(int num_opponents);
+
+  template <EvaluatorType kEvaluator>
+  static WorkerFn enumerator_for(int num_opponents);
+
+  template <EvaluatorType kEvaluator>
+  static WorkerFn weighted_worker_for(int num_opponents);
+
+  // Monte Carlo: a chunk is kSimulationsPerChunk random deals. kBatch
+  // deals several at a time: OMPEval's SIMD batches (SIMD) or interleaved
+  // Two Plus Two walks (PREFETCHING).
+  template <EvaluatorType kEvaluator, bool kBatch, int kOpponents>
+  void run_chunk(const HandTask& task, int chunk, HandAccumulator& classes);
+
+  // Weighted opponent ranges: each seat's hand is drawn from the hand's
+  // table of the combos its range leaves open, then the board is dealt
+  template <EvaluatorType kEvaluator, int kOpponents>
+  void run_weighted_chunk(const HandTask& task, int chunk, HandAccumulator& classes);
+
+  // Exhaustive: a chunk is the next kSimulationsPerChunk deals in
+  // RunoutEnumerator order
+  template <EvaluatorType kEvaluator, int kOpponents>
+  void run_enumeration_chunk(const HandTask& task, int chunk, HandAccumulator& classes);
+
+  // Board-major kernels run a chunk of deals shared by the whole range:
+  // each deal's board and opponents are dealt and evaluated once, then
+  // every hero hand whose cards it does not use is scored against it
+  using BoardWorkerFn = void (EquityEngine::*)(RangeJob& job, int chunk);
+
+  static BoardWorkerFn select_board_worker(EvaluatorType evaluator, int num_opponents);
+
+  template <EvaluatorType kEvaluator>
+  static BoardWorkerFn board_worker_for(int num_opponents);
+
+  template <EvaluatorType kEvaluator, int kOpponents>
+  void run_board_chunk(RangeJob& job, int chunk);
+
+  void run_board_major(RangeJob& job, bool parallel,
+                       std::unordered_map<std::string, EquityResult>& results);
+
+  // River grid mode: every hand class of the grid, and every hand of the
+  // range spec under its own name, against a random hand or the opponent
+  // range. Throws std::invalid_argument unless the board is complete and
+  // heads-up, or if the range leaves a spec hand no opponent.
+  void solve_river_grid(const JobRequest& request,
+                        std::unordered_map<std::string, EquityResult>& results);
+
+  // Plans the next round: sets each unfinished hand's chunks for it and
+  // finishes the hands that get none. Returns false when all are finished.
+  bool plan_round(RangeJob& job);
+
+  // Total chunks a hand should have after the next round, per schedule
+  int precision_chunk_target(const RangeJob& job, const HandTask& hand) const;
+  std::vector<int> neyman_chunk_targets(const RangeJob& job) const;
+
+  // Runs every hand's chunks planned for this round, on the pool or inline
+  void run_round(RangeJob& job, bool parallel,
+                 std::unordered_map<std::string, EquityResult>& results);
+
+  // One (hand, chunk) task: runs the kernel, merges into the hand, and
+  // finishes the hand if it was the hand's last chunk
+  void run_hand_chunk(RangeJob& job, HandTask& hand, int chunk);
+  void finish_hand(RangeJob& job, HandTask& hand);
+
+  // Publishes progress to shared memory (counts, results, pool
+  // utilization) and to the progress callback when a hand or a round has
+  // finished
+  void report_progress(RangeJob& job, std::unordered_map<std::string, EquityResult>& results);
+
+  // Rebuilds the name-keyed results map handed to callers and shared memory:
+  // the job's opponent classes, then the finished hands' overall results
+  // (with include_running, hands in progress count as far as they got)
+  void publish_results(RangeJob& job, bool include_running,
+                       std::unordered_map<std::string, EquityResult>& results) const;
+
+  // The evaluator picked at compile time, and a hand evaluated with it
+  template <EvaluatorType kEvaluator>
+  const auto& evaluator() const;
+  template <EvaluatorType kEvaluator>
+  int32_t evaluate(CardIds cards) const;
+
+  // Value of the hole cards in slots 0-1: one load from the dealt board's
+  // rank vector when the job has one, otherwise an evaluation
+  template <EvaluatorType kEvaluator>
+  int32_t showdown_value(const int32_t* board_ranks, CardIds cards) const;
+
+  // BOARD_CACHE: computes a board's rank vector on a cache miss, OMPEval
+  // through its batch kernel
+  template <EvaluatorType kEvaluator>
+  void fill_board_ranks(const std::array<uint8_t, 5>& board, BoardRanks& ranks) const;
+  BoardRankCache::Fill board_rank_filler(EvaluatorType evaluator) const;
 };
 
 }  // namespace poker_engine
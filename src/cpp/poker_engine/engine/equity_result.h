@@ -12,6 +12,8 @@ struct EquityResult {
     uint32_t ties;
     uint32_t losses;
     uint32_t total_simulations;
+    // Standard error of `equity`; 0 when every deal was enumerated
+    double std_error;
 
     // 10x10 matrices for win/loss method tracking
     // [our_type][opp_type] for wins, [opp_type][our_type] for losses
@@ -19,7 +21,7 @@ struct EquityResult {
     uint32_t loss_method_matrix[10][10];
 
     EquityResult()
-        : equity(0.0), wins(0), ties(0), losses(0), total_simulations(0) {
+        : equity(0.0), wins(0), ties(0), losses(0), total_simulations(0), std_error(0.0) {
         for (int i = 0; i < 10; ++i) {
             for (int j = 0; j < 10; ++j) {
                 win_method_matrix[i][j] = 0;
@@ -0,0 +1,54 @@
+#include "evaluator_registry.h"
+
+#include <mutex>
+
+#include "core/deck.h"
+
+namespace poker_engine {
+
+namespace {
+
+// Hands each evaluator plays while warming up
+constexpr int kWarmUpHands = 4096;
+
+// Where warm-up results go, so its reads are not optimized out
+volatile int32_t warm_up_sink;
+
+}  // namespace
+
+std::atomic<bool> EvaluatorRegistry::ready_{false};
+
+const EvaluatorRegistry& EvaluatorRegistry::instance() {
+  static const EvaluatorRegistry registry;
+  return registry;
+}
+
+void EvaluatorRegistry::warm_up() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    const EvaluatorRegistry& registry = instance();
+
+    // One read per page maps the whole table into this process
+    int32_t sink = 0;
+    if (const HandRanksTable* table = registry.tpt_.table()) {
+      constexpr size_t kEntriesPerPage = 4096 / sizeof(int32_t);
+      for (size_t i = 0; i < table->size(); i += kEntriesPerPage) sink ^= table->data()[i];
+    }
+
+    Deck deck(0x5EED);
+    uint8_t ids[kMaxHandCards];
+    for (int hand = 0; hand < kWarmUpHands; ++hand) {
+      deck.reset();
+      for (uint8_t& id : ids) id = card_id(deck.draw_random());
+      const CardIds cards(ids, kMaxHandCards);
+      sink ^= registry.naive_.evaluate(cards) ^ registry.cactus_kev_.evaluate(cards) ^
+              registry.ph_.evaluate(cards) ^ registry.tpt_.evaluate(cards) ^
+              registry.omp_.evaluate(cards);
+    }
+    warm_up_sink = sink;
+
+    ready_.store(true, std::memory_order_release);
+  });
+}
+
+}  // namespace poker_engine
@@ -0,0 +1,58 @@
+#ifndef ENGINE_EVALUATOR_REGISTRY_H
+#define ENGINE_EVALUATOR_REGISTRY_H
+
+#include <atomic>
+
+#include "evaluators/cactus_kev_evaluator.h"
+#include "evaluators/naive_evaluator.h"
+#include "evaluators/omp_eval.h"
+#include "evaluators/ph_evaluator.h"
+#include "evaluators/two_plus_two_evaluator.h"
+
+namespace poker_engine {
+
+/**
+ * @brief Every evaluator an engine can run, built once per process.
+ *
+ * Evaluation is const and the evaluators hold no per-call state, so every
+ * engine on every thread borrows the same instances. The server warms the
+ * registry at startup and reports ready on /health once it has; an engine
+ * built before then simply waits for construction to finish.
+ */
+class EvaluatorRegistry {
+ public:
+  // The process's registry, built on first use
+  static const EvaluatorRegistry& instance();
+
+  // Builds the registry if needed, faults in every page of the lookup
+  // tables and runs each evaluator over a few thousand hands, so the first
+  // job pays no cold start. Safe to call more than once, from any thread.
+  static void warm_up();
+
+  // Whether warm_up() has finished
+  static bool ready() { return ready_.load(std::memory_order_acquire); }
+
+  EvaluatorRegistry(const EvaluatorRegistry&) = delete;
+  EvaluatorRegistry& operator=(const EvaluatorRegistry&) = delete;
+
+  const NaiveEvaluator& naive() const { return naive_; }
+  const CactusKevEvaluator& cactus_kev() const { return cactus_kev_; }
+  const PHEvaluator& ph() const { return ph_; }
+  const TwoPlusTwoEvaluator& two_plus_two() const { return tpt_; }
+  const OMPEval& omp() const { return omp_; }
+
+ private:
+  EvaluatorRegistry() = default;
+
+  NaiveEvaluator naive_;
+  CactusKevEvaluator cactus_kev_;
+  PHEvaluator ph_;
+  TwoPlusTwoEvaluator tpt_;
+  OMPEval omp_;
+
+  static std::atomic<bool> ready_;
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_EVALUATOR_REGISTRY_H
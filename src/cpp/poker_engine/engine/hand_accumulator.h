@@ -0,0 +1,155 @@
+#ifndef ENGINE_HAND_ACCUMULATOR_H
+#define ENGINE_HAND_ACCUMULATOR_H
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include "core/hand_index.h"
+#include "equity_result.h"
+#include "evaluators/hand_types.h"
+
+namespace poker_engine {
+
+// Win/tie/loss counts and method matrices for one opponent hand class
+struct OutcomeCounts {
+  uint32_t wins = 0;
+  uint32_t ties = 0;
+  uint32_t losses = 0;
+  uint32_t total = 0;
+  // [our_type][opp_type] for wins, [opp_type][our_type] for losses
+  uint32_t win_method_matrix[10][10] = {};
+  uint32_t loss_method_matrix[10][10] = {};
+
+  void record(int32_t our_value, int32_t max_opponent) {
+    total++;
+    if (our_value > max_opponent) {
+      wins++;
+      win_method_matrix[get_hand_type(our_value)][get_hand_type(max_opponent)]++;
+    } else if (our_value == max_opponent) {
+      ties++;
+    } else {
+      losses++;
+      loss_method_matrix[get_hand_type(max_opponent)][get_hand_type(our_value)]++;
+    }
+  }
+
+  OutcomeCounts& operator+=(const OutcomeCounts& other) {
+    wins += other.wins;
+    ties += other.ties;
+    losses += other.losses;
+    total += other.total;
+    for (int i = 0; i < 10; ++i) {
+      for (int j = 0; j < 10; ++j) {
+        win_method_matrix[i][j] += other.win_method_matrix[i][j];
+        loss_method_matrix[i][j] += other.loss_method_matrix[i][j];
+      }
+    }
+    return *this;
+  }
+};
+
+/**
+ * @brief One hero hand's simulations, split by the hand class of the
+ * strongest opponent.
+ *
+ * A flat array indexed by hand class (see core/hand_index.h), so recording
+ * a simulation is an index and merging two accumulators is an array add.
+ * The extra slot kNoOpponent holds simulations without opponents ("??").
+ *
+ * Recorded slots are also tracked in a bitmask, so draining a mostly-empty
+ * per-chunk accumulator into a hand's only touches the classes it saw.
+ */
+class HandAccumulator {
+ public:
+  static constexpr int kNoOpponent = kNumHandClasses;
+  static constexpr int kSlots = kNumHandClasses + 1;
+
+  void record(int opp_class, int32_t our_value, int32_t max_opponent) {
+    touched_.set(opp_class);
+    slots_[opp_class].record(our_value, max_opponent);
+  }
+
+  // Adds every recorded slot into `out`, `copies` times, and leaves this
+  // accumulator empty
+  void drain_into(HandAccumulator& out, size_t copies = 1) {
+    for (int slot = 0; slot < kSlots; ++slot) {
+      if (!touched_.test(slot)) continue;
+      for (size_t i = 0; i < copies; ++i) out.slots_[slot] += slots_[slot];
+      out.touched_.set(slot);
+      slots_[slot] = OutcomeCounts();
+    }
+    touched_.reset();
+  }
+
+  HandAccumulator& operator+=(const HandAccumulator& other) {
+    for (int i = 0; i < kSlots; ++i) slots_[i] += other.slots_[i];
+    touched_ |= other.touched_;
+    return *this;
+  }
+
+  void clear() {
+    slots_.fill(OutcomeCounts());
+    touched_.reset();
+  }
+
+  const OutcomeCounts& operator[](int slot) const { return slots_[slot]; }
+
+  // Every class summed: the hero hand's overall result
+  OutcomeCounts total() const {
+    OutcomeCounts sum;
+    for (int slot = 0; slot < kSlots; ++slot) {
+      if (touched_.test(slot)) sum += slots_[slot];
+    }
+    return sum;
+  }
+
+  static std::string slot_name(int slot) {
+    return slot == kNoOpponent ? "??" : hand_class_name(slot);
+  }
+
+ private:
+  std::array<OutcomeCounts, kSlots> slots_{};
+  std::bitset<kSlots> touched_;
+};
+
+// Sample variance of the per-simulation payoff (1 for a win, 1/2 for a
+// tie, 0 for a loss). Below two simulations it is the largest possible
+// variance, 1/4.
+inline double equity_variance(uint64_t wins, uint64_t ties, uint64_t total) {
+  if (total < 2) return 0.25;
+  const double n = static_cast<double>(total);
+  const double mean = (wins + ties * 0.5) / n;
+  const double sum_squares = wins + ties * 0.25;
+  return std::max(0.0, (sum_squares - n * mean * mean) / (n - 1));
+}
+
+// Standard error of the equity estimate (wins + ties / 2) / total
+inline double equity_std_error(uint64_t wins, uint64_t ties, uint64_t total) {
+  return std::sqrt(equity_variance(wins, ties, total) / std::max<uint64_t>(total, 1));
+}
+
+// Adds `counts` onto `result` and recomputes its equity and standard error
+inline void add_to_result(const OutcomeCounts& counts, EquityResult& result) {
+  result.wins += counts.wins;
+  result.ties += counts.ties;
+  result.losses += counts.losses;
+  result.total_simulations += counts.total;
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      result.win_method_matrix[i][j] += counts.win_method_matrix[i][j];
+      result.loss_method_matrix[i][j] += counts.loss_method_matrix[i][j];
+    }
+  }
+  if (result.total_simulations > 0) {
+    result.equity = (result.wins + result.ties * 0.5) / result.total_simulations;
+    result.std_error = equity_std_error(result.wins, result.ties, result.total_simulations);
+  }
+}
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_HAND_ACCUMULATOR_H
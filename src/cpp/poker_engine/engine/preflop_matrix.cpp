@@ -0,0 +1,175 @@
+#include "preflop_matrix.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "core/suit_permutations.h"
+
+namespace poker_engine {
+
+namespace {
+
+template <typename T>
+void append_le(std::string& out, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i) out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+// Combos of each class that avoid one combo of another: [hero][villain]
+const auto kOpenCombos = [] {
+  std::array<std::array<uint16_t, kNumHandClasses>, kNumHandClasses> table{};
+  std::array<int, kNumHandClasses> first_combo;
+  first_combo.fill(-1);
+  for (int combo = 0; combo < kNumHandCombos; ++combo) {
+    int& first = first_combo[hand_index_tables::kClassOfCombo[combo]];
+    if (first < 0) first = combo;
+  }
+  for (int hero = 0; hero < kNumHandClasses; ++hero) {
+    const auto& hero_cards = hand_index_tables::kComboCards[first_combo[hero]];
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+      const auto& cards = hand_index_tables::kComboCards[combo];
+      bool blocked = false;
+      for (uint8_t c : cards) blocked |= (c == hero_cards[0] || c == hero_cards[1]);
+      if (!blocked) table[hero][hand_index_tables::kClassOfCombo[combo]]++;
+    }
+  }
+  return table;
+}();
+
+float row_average(const std::vector<float>& rates, int hero) {
+  double sum = 0.0;
+  double weight = 0.0;
+  for (int villain = 0; villain < kNumHandClasses; ++villain) {
+    sum += kOpenCombos[hero][villain] * static_cast<double>(rates[hero * kNumHandClasses + villain]);
+    weight += kOpenCombos[hero][villain];
+  }
+  return static_cast<float>(sum / weight);
+}
+
+}  // namespace
+
+float PreflopMatrix::win_rate_vs_random(int hero) const { return row_average(win, hero); }
+
+float PreflopMatrix::tie_rate_vs_random(int hero) const { return row_average(tie, hero); }
+
+std::string PreflopMatrix::to_binary() const {
+  std::string out = "PFM1";
+  out.reserve(4 + 4 + 8 + 2 * win.size() * sizeof(float));
+  append_le<uint32_t>(out, kSize);
+  append_le<uint64_t>(out, boards);
+  for (const auto* rates : {&win, &tie}) {
+    for (float rate : *rates) {
+      uint32_t bits;
+      std::memcpy(&bits, &rate, sizeof(bits));
+      append_le(out, bits);
+    }
+  }
+  return out;
+}
+
+const MatrixMatchups& matrix_matchups() {
+  static const MatrixMatchups matchups = [] {
+    std::array<std::vector<int>, kNumHandClasses> class_combos;
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+      class_combos[hand_index_tables::kClassOfCombo[combo]].push_back(combo);
+    }
+
+    MatrixMatchups m;
+    for (int hero_class = 0; hero_class < kNumHandClasses; ++hero_class) {
+      const int hero = class_combos[hero_class].front();
+      const auto& hero_cards = hand_index_tables::kComboCards[hero];
+      const uint64_t hero_mask = (uint64_t{1} << hero_cards[0]) | (uint64_t{1} << hero_cards[1]);
+
+      // Relabellings that map the hero combo onto itself
+      std::vector<std::array<uint8_t, 4>> stabilizer;
+      for (const auto& perm : kSuitPermutations) {
+        if (hand_combo_index(relabel_suit(hero_cards[0], perm),
+                             relabel_suit(hero_cards[1], perm)) == hero) {
+          stabilizer.push_back(perm);
+        }
+      }
+
+      for (int villain_class = hero_class; villain_class < kNumHandClasses; ++villain_class) {
+        // Each villain combo under its smallest image, with its count
+        std::vector<std::pair<int, uint32_t>> images;
+        for (int villain : class_combos[villain_class]) {
+          const auto& cards = hand_index_tables::kComboCards[villain];
+          if (hero_mask & ((uint64_t{1} << cards[0]) | (uint64_t{1} << cards[1]))) continue;
+          int image = villain;
+          for (const auto& perm : stabilizer) {
+            image = std::min(image, hand_combo_index(relabel_suit(cards[0], perm),
+                                                     relabel_suit(cards[1], perm)));
+          }
+          auto it = std::find_if(images.begin(), images.end(),
+                                 [image](const auto& entry) { return entry.first == image; });
+          if (it == images.end()) {
+            images.emplace_back(image, 1);
+          } else {
+            it->second++;
+          }
+        }
+        for (const auto& [villain, count] : images) {
+          const auto& cards = hand_index_tables::kComboCards[villain];
+          m.hero.push_back(static_cast<uint16_t>(hero));
+          m.villain.push_back(static_cast<uint16_t>(villain));
+          m.mask.push_back(hero_mask | (uint64_t{1} << cards[0]) | (uint64_t{1} << cards[1]));
+          m.cell_hero.push_back(static_cast<uint16_t>(hero_class));
+          m.cell_villain.push_back(static_cast<uint16_t>(villain_class));
+          m.weight.push_back(count);
+        }
+      }
+    }
+    return m;
+  }();
+  return matchups;
+}
+
+void MatchupCounts::clear() {
+  std::fill(wins.begin(), wins.end(), 0);
+  std::fill(ties.begin(), ties.end(), 0);
+  std::fill(total.begin(), total.end(), 0);
+}
+
+MatchupCounts& MatchupCounts::operator+=(const MatchupCounts& other) {
+  for (size_t i = 0; i < wins.size(); ++i) {
+    wins[i] += other.wins[i];
+    ties[i] += other.ties[i];
+    total[i] += other.total[i];
+  }
+  return *this;
+}
+
+PreflopMatrix assemble_preflop_matrix(const MatrixMatchups& matchups, const MatchupCounts& counts,
+                                      uint64_t boards) {
+  constexpr int kSize = PreflopMatrix::kSize;
+  std::vector<double> win(kSize * kSize), tie(kSize * kSize), weight(kSize * kSize);
+  for (size_t i = 0; i < matchups.size(); ++i) {
+    if (counts.total[i] == 0) continue;
+    const int cell = matchups.cell_hero[i] * kSize + matchups.cell_villain[i];
+    const double w = matchups.weight[i];
+    win[cell] += w * counts.wins[i] / counts.total[i];
+    tie[cell] += w * counts.ties[i] / counts.total[i];
+    weight[cell] += w;
+  }
+
+  PreflopMatrix matrix;
+  matrix.boards = boards;
+  for (int hero = 0; hero < kSize; ++hero) {
+    for (int villain = hero; villain < kSize; ++villain) {
+      const int cell = hero * kSize + villain;
+      if (weight[cell] == 0.0) continue;
+      double win_rate = win[cell] / weight[cell];
+      const double tie_rate = tie[cell] / weight[cell];
+      double loss_rate = 1.0 - win_rate - tie_rate;
+      if (hero == villain) win_rate = loss_rate = 0.5 * (win_rate + loss_rate);
+      matrix.win[cell] = static_cast<float>(win_rate);
+      matrix.tie[cell] = static_cast<float>(tie_rate);
+      matrix.win[villain * kSize + hero] = static_cast<float>(loss_rate);
+      matrix.tie[villain * kSize + hero] = static_cast<float>(tie_rate);
+    }
+  }
+  return matrix;
+}
+
+}  // namespace poker_engine
@@ -0,0 +1,81 @@
+#ifndef ENGINE_PREFLOP_MATRIX_H
+#define ENGINE_PREFLOP_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/hand_index.h"
+
+namespace poker_engine {
+
+/**
+ * @brief Heads-up preflop equity of every hand class against every other.
+ *
+ * Cell [hero][villain] (hand_class_index order, row-major) averages over
+ * every pair of one hero combo and one villain combo that share no card.
+ * Rates are for the row class: it loses 1 - win - tie of the time.
+ */
+struct PreflopMatrix {
+  static constexpr int kSize = kNumHandClasses;
+
+  std::vector<float> win = std::vector<float>(kSize * kSize);
+  std::vector<float> tie = std::vector<float>(kSize * kSize);
+  uint64_t boards = 0;  // random boards dealt; a matchup scores those that miss its cards
+
+  float win_rate(int hero, int villain) const { return win[hero * kSize + villain]; }
+  float tie_rate(int hero, int villain) const { return tie[hero * kSize + villain]; }
+  float equity(int hero, int villain) const {
+    return win_rate(hero, villain) + 0.5f * tie_rate(hero, villain);
+  }
+
+  // The row class against a random hand: its cells weighted by how many
+  // villain combos each leaves a hero combo
+  float win_rate_vs_random(int hero) const;
+  float tie_rate_vs_random(int hero) const;
+
+  // "PFM1", then little-endian uint32 kSize and uint64 boards, then the
+  // win and the tie matrix as float32, row-major
+  std::string to_binary() const;
+};
+
+// The matchups a matrix is solved from: one per (hero class <= villain
+// class) cell and suit-relabelling class of combo pairs. Every hero combo
+// of a class is a relabelling of the others, so one stands for the class;
+// villain combos then merge when a relabelling that fixes the hero combo
+// maps one onto the other. `weight` counts the cell's combo pairs a
+// matchup stands for.
+struct MatrixMatchups {
+  std::vector<uint16_t> hero;     // combo index
+  std::vector<uint16_t> villain;  // combo index
+  std::vector<uint64_t> mask;     // the four cards, bit card_id
+  std::vector<uint16_t> cell_hero;
+  std::vector<uint16_t> cell_villain;
+  std::vector<uint32_t> weight;
+
+  size_t size() const { return hero.size(); }
+};
+
+// Built on first use and shared
+const MatrixMatchups& matrix_matchups();
+
+// Wins, ties and boards scored of each matchup
+struct MatchupCounts {
+  std::vector<uint32_t> wins;
+  std::vector<uint32_t> ties;
+  std::vector<uint32_t> total;
+
+  explicit MatchupCounts(size_t n = 0) : wins(n), ties(n), total(n) {}
+  void clear();
+  MatchupCounts& operator+=(const MatchupCounts& other);
+};
+
+// Weights each cell's matchups into its rates and mirrors the cells below
+// the diagonal: villain vs hero wins when hero vs villain loses. A class
+// against itself is symmetric, so its wins and losses are averaged.
+PreflopMatrix assemble_preflop_matrix(const MatrixMatchups& matchups, const MatchupCounts& counts,
+                                      uint64_t boards);
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_PREFLOP_MATRIX_H
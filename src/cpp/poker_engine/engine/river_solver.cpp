@@ -0,0 +1,104 @@
+#include "river_solver.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "evaluators/hand_types.h"
+
+namespace poker_engine {
+
+ComboWeights RiverSolver::uniform_weights(const BoardRanks& ranks) {
+  ComboWeights weights{};
+  for (int combo = 0; combo < kNumHandCombos; ++combo) weights[combo] = ranks[combo] > 0 ? 1 : 0;
+  return weights;
+}
+
+RiverSolver::RiverSolver(const BoardRanks& ranks, const ComboWeights& opponent_weights)
+    : ranks_(ranks), weights_(opponent_weights) {
+  std::vector<int> order;
+  order.reserve(kNumHandCombos);
+  for (int combo = 0; combo < kNumHandCombos; ++combo) {
+    if (ranks_[combo] > 0) order.push_back(combo);
+  }
+  std::sort(order.begin(), order.end(), [this](int a, int b) { return ranks_[a] < ranks_[b]; });
+
+  // Sweep one group of equal values at a time: every combo in it sees the
+  // sums before the group as "below" and after it as "up to"
+  std::array<uint64_t, 52> card_sum{};
+  uint64_t sum = 0;
+  for (size_t first = 0; first < order.size();) {
+    size_t last = first;
+    while (last < order.size() && ranks_[order[last]] == ranks_[order[first]]) ++last;
+
+    for (size_t i = first; i < last; ++i) {
+      const int combo = order[i];
+      all_[combo].below = sum;
+      for (int k = 0; k < 2; ++k) {
+        by_card_[combo][k].below = card_sum[hand_index_tables::kComboCards[combo][k]];
+      }
+    }
+    for (size_t i = first; i < last; ++i) {
+      const int combo = order[i];
+      const uint64_t weight = weights_[combo];
+      const HandType type = get_hand_type(ranks_[combo]);
+      sum += weight;
+      type_weight_[type] += weight;
+      for (uint8_t card : hand_index_tables::kComboCards[combo]) {
+        card_sum[card] += weight;
+        card_type_weight_[card][type] += weight;
+      }
+    }
+    for (size_t i = first; i < last; ++i) {
+      const int combo = order[i];
+      all_[combo].up_to = sum;
+      for (int k = 0; k < 2; ++k) {
+        by_card_[combo][k].up_to = card_sum[hand_index_tables::kComboCards[combo][k]];
+      }
+    }
+    first = last;
+  }
+  total_weight_ = sum;
+  card_weight_ = card_sum;
+}
+
+ComboShowdown RiverSolver::solve(int combo) const {
+  ComboShowdown result;
+  const int32_t value = ranks_[combo];
+  if (value <= 0) return result;
+
+  // Opponent combos holding either hero card are blocked. Only the hero
+  // combo itself holds both, and it ties, so it is added back to the ties
+  // and the total once.
+  const auto& cards = hand_index_tables::kComboCards[combo];
+  const Prefix& first = by_card_[combo][0];
+  const Prefix& second = by_card_[combo][1];
+  const uint64_t self = weights_[combo];
+  const uint64_t below = all_[combo].below - first.below - second.below;
+  const uint64_t up_to = all_[combo].up_to - first.up_to - second.up_to + self;
+  result.total = total_weight_ - card_weight_[cards[0]] - card_weight_[cards[1]] + self;
+  result.wins = below;
+  result.ties = up_to - below;
+  result.losses = result.total - up_to;
+
+  // Every weaker type is all wins and every stronger one all losses; our
+  // own type takes the rest of each
+  const int type = get_hand_type(value);
+  const auto& first_types = card_type_weight_[cards[0]];
+  const auto& second_types = card_type_weight_[cards[1]];
+  auto open_weight = [&](int t) { return type_weight_[t] - first_types[t] - second_types[t]; };
+  uint64_t other_wins = 0;
+  for (int t = 0; t < type; ++t) {
+    result.wins_by_opp_type[t] = open_weight(t);
+    other_wins += result.wins_by_opp_type[t];
+  }
+  result.wins_by_opp_type[type] = result.wins - other_wins;
+  uint64_t other_losses = 0;
+  for (int t = type + 1; t < 10; ++t) {
+    result.losses_by_opp_type[t] = open_weight(t);
+    other_losses += result.losses_by_opp_type[t];
+  }
+  result.losses_by_opp_type[type] = result.losses - other_losses;
+  return result;
+}
+
+}  // namespace poker_engine
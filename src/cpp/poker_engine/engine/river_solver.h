@@ -0,0 +1,68 @@
+#ifndef ENGINE_RIVER_SOLVER_H
+#define ENGINE_RIVER_SOLVER_H
+
+#include <array>
+#include <cstdint>
+
+#include "board_rank_cache.h"
+
+namespace poker_engine {
+
+// Weight of each opponent combo, by hand_combo_index
+using ComboWeights = std::array<uint32_t, kNumHandCombos>;
+
+// One hero combo's heads-up showdowns against the opponent range, with
+// the hand types each side won or lost with
+struct ComboShowdown {
+  uint64_t wins = 0;
+  uint64_t ties = 0;
+  uint64_t losses = 0;
+  uint64_t total = 0;
+  std::array<uint64_t, 10> wins_by_opp_type{};    // opponent's type when we win
+  std::array<uint64_t, 10> losses_by_opp_type{};  // opponent's type when we lose
+};
+
+/**
+ * @brief Exact heads-up equity of every combo on a complete board.
+ *
+ * Combos are sorted by their value on the board once, and one sweep over
+ * them in that order keeps prefix sums of the opponent range's weight,
+ * overall and for the combos holding each card. Each combo then knows the
+ * weight below and up to its value, and the weight its own two cards
+ * block from both, so its wins, ties and losses are a few subtractions:
+ * O(n log n) for the whole board instead of sampling matchups.
+ */
+class RiverSolver {
+ public:
+  // `ranks` holds every combo's value on the board (0 for combos that
+  // use a board card; those never count as opponents)
+  RiverSolver(const BoardRanks& ranks, const ComboWeights& opponent_weights);
+
+  // Every combo that avoids the board, weight 1
+  static ComboWeights uniform_weights(const BoardRanks& ranks);
+
+  // Showdowns of hero combo `combo`; empty if it uses a board card
+  ComboShowdown solve(int combo) const;
+
+ private:
+  // Opponent weight strictly below and up to a combo's value: overall,
+  // and among the combos holding its first and its second card
+  struct Prefix {
+    uint64_t below = 0;
+    uint64_t up_to = 0;
+  };
+
+  const BoardRanks& ranks_;
+  const ComboWeights& weights_;
+  std::array<Prefix, kNumHandCombos> all_{};
+  std::array<std::array<Prefix, 2>, kNumHandCombos> by_card_{};
+  uint64_t total_weight_ = 0;
+  std::array<uint64_t, 52> card_weight_{};
+  // Weight of each hand type, overall and among each card's combos
+  std::array<uint64_t, 10> type_weight_{};
+  std::array<std::array<uint64_t, 10>, 52> card_type_weight_{};
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_RIVER_SOLVER_H
@@ -0,0 +1,156 @@
+#ifndef ENGINE_RUNOUT_ENUMERATOR_H
+#define ENGINE_RUNOUT_ENUMERATOR_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace poker_engine {
+
+// C(n, k) for the small n and k of card dealing
+constexpr uint64_t binomial(int n, int k) {
+  if (k < 0 || n < 0 || k > n) return 0;
+  uint64_t result = 1;
+  for (int i = 1; i <= k; ++i) {
+    result = result * static_cast<uint64_t>(n - k + i) / static_cast<uint64_t>(i);
+  }
+  return result;
+}
+
+/**
+ * @brief Walks every deal of the missing board cards and the opponents'
+ * hole cards exactly once.
+ *
+ * A deal is one combination per level: level 0 completes the board from
+ * the live cards, level i > 0 gives opponent i two of the cards left after
+ * the levels before it. Each level's combination is ranked in the
+ * combinatorial number system (colex order) and the deal's index is the
+ * mixed-radix number of those ranks, board most significant. seek() jumps
+ * straight to any index, so a job can cut [0, count) into equal chunks;
+ * next() steps in index order and reports the first level that changed, so
+ * callers only re-evaluate the hands that depend on it.
+ */
+class RunoutEnumerator {
+ public:
+  static constexpr int kMaxLevels = 10;  // the board plus up to 9 opponents
+
+  // Number of deals for one hero hand: the 52 cards minus two hole cards
+  // and `known_board` board cards. Saturates at UINT64_MAX.
+  static uint64_t count(int known_board, int num_opponents) {
+    const int live = 52 - 2 - known_board;
+    const int to_deal = 5 - known_board;
+    if (to_deal < 0 || num_opponents < 0) return 0;
+    uint64_t total = binomial(live, to_deal);
+    for (int i = 0; i < num_opponents; ++i) {
+      const uint64_t hands = binomial(live - to_deal - 2 * i, 2);
+      if (hands != 0 && total > std::numeric_limits<uint64_t>::max() / hands) {
+        return std::numeric_limits<uint64_t>::max();
+      }
+      total *= hands;
+    }
+    return total;
+  }
+
+  // `live_mask` has bit card_id set for every card that may be dealt
+  RunoutEnumerator(uint64_t live_mask, int board_cards, int num_opponents)
+      : num_levels_(1 + num_opponents) {
+    level_size_[0] = board_cards;
+    for (int level = 1; level < num_levels_; ++level) level_size_[level] = 2;
+
+    live_size_[0] = 0;
+    for (int id = 0; id < 52; ++id) {
+      if (live_mask & (1ULL << id)) live_[0][live_size_[0]++] = static_cast<uint8_t>(id);
+    }
+    seek(0);
+  }
+
+  // Positions the enumerator on deal `index` (< count())
+  void seek(uint64_t index) {
+    // Radix of each level is fixed: its live count only depends on how
+    // many cards the levels before it took
+    std::array<uint64_t, kMaxLevels> digits{};
+    for (int level = num_levels_ - 1; level >= 0; --level) {
+      const int live = live_size_[0] - cards_before(level);
+      const uint64_t radix = binomial(live, level_size_[level]);
+      digits[level] = radix ? index % radix : 0;
+      index = radix ? index / radix : 0;
+    }
+    for (int level = 0; level < num_levels_; ++level) {
+      unrank(level, digits[level]);
+      if (level + 1 < num_levels_) fill_live(level + 1);
+    }
+  }
+
+  // Steps to the next deal. Returns the first level that changed (its
+  // cards and every later level's are new), or -1 after the last deal.
+  int next() {
+    for (int level = num_levels_ - 1; level >= 0; --level) {
+      if (!advance(level)) continue;
+      for (int later = level + 1; later < num_levels_; ++later) {
+        fill_live(later);
+        for (int j = 0; j < level_size_[later]; ++j) pos_[later][j] = static_cast<uint8_t>(j);
+      }
+      return level;
+    }
+    return -1;
+  }
+
+  // Card id `j` of a level: board card j at level 0, opponent hole card j
+  // at level o + 1
+  uint8_t card(int level, int j) const { return live_[level][pos_[level][j]]; }
+
+ private:
+  int cards_before(int level) const {
+    return level == 0 ? 0 : level_size_[0] + 2 * (level - 1);
+  }
+
+  // Live cards of `level`: the previous level's minus the ones it took
+  void fill_live(int level) {
+    const int prev = level - 1;
+    uint64_t taken = 0;
+    for (int j = 0; j < level_size_[prev]; ++j) taken |= 1ULL << pos_[prev][j];
+    int size = 0;
+    for (int i = 0; i < live_size_[prev]; ++i) {
+      if (!(taken & (1ULL << i))) live_[level][size++] = live_[prev][i];
+    }
+    live_size_[level] = size;
+  }
+
+  // Combination of rank `rank` in colex order: the largest c_j with
+  // C(c_j, j + 1) <= rank, from the top position down
+  void unrank(int level, uint64_t rank) {
+    int c = live_size_[level];
+    for (int j = level_size_[level] - 1; j >= 0; --j) {
+      do {
+        --c;
+      } while (binomial(c, j + 1) > rank);
+      pos_[level][j] = static_cast<uint8_t>(c);
+      rank -= binomial(c, j + 1);
+    }
+  }
+
+  // Colex successor: bump the lowest position that has room and restart
+  // the ones below it
+  bool advance(int level) {
+    const int k = level_size_[level];
+    for (int j = 0; j < k; ++j) {
+      const int limit = j + 1 < k ? pos_[level][j + 1] : live_size_[level];
+      if (pos_[level][j] + 1 < limit) {
+        pos_[level][j]++;
+        for (int i = 0; i < j; ++i) pos_[level][i] = static_cast<uint8_t>(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int num_levels_;
+  std::array<int, kMaxLevels> level_size_{};
+  std::array<int, kMaxLevels> live_size_{};
+  std::array<std::array<uint8_t, 52>, kMaxLevels> live_{};
+  std::array<std::array<uint8_t, 5>, kMaxLevels> pos_{};
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_RUNOUT_ENUMERATOR_H
@@ -1,6 +1,7 @@
 #ifndef ENGINE_SHARED_MEMORY_TYPES_H
 #define ENGINE_SHARED_MEMORY_TYPES_H
 
+#include <cstddef>
 #include <cstdint>
 #include <atomic>
 
@@ -15,7 +16,8 @@ struct HandEquityResult {
     uint32_t simulations;
     uint32_t win_method_matrix[10][10];
     uint32_t loss_method_matrix[10][10];
-    uint32_t _padding[2];
+    float std_error;  // of equity; 0 when exact
+    uint32_t _padding;
 };
 static_assert(sizeof(HandEquityResult) == 832, "HandEquityResult must be 832 bytes");
 
@@ -33,9 +35,16 @@ struct alignas(64) TelemetrySharedMemory {
     uint64_t hands_processed;
     uint64_t last_update_ns;
     uint8_t status;
-    uint8_t _reserved[31];
+    uint8_t _padding2[3];
+    // Worker pool (carved out of the former _reserved bytes; 0 = not reported)
+    uint32_t pool_threads;
+    float pool_utilization;  // busy fraction since the previous update, 0-1
+    uint32_t pool_queued_tasks;
+    uint64_t pool_tasks_completed;
+    uint64_t pool_tasks_stolen;
 };
 static_assert(sizeof(TelemetrySharedMemory) == 64, "Must be 64 bytes");
+static_assert(offsetof(TelemetrySharedMemory, pool_threads) == 36, "Pool fields follow status");
 static_assert(alignof(TelemetrySharedMemory) == 64, "Must be 64-byte aligned");
 
 struct CompleteSharedMemory {
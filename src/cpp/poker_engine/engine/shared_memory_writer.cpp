@@ -92,6 +92,19 @@ void SharedMemoryWriter::set_status(uint8_t status) {
     data_->telemetry.seq.fetch_add(1, std::memory_order_release);
 }
 
+void SharedMemoryWriter::update_pool(uint32_t threads, float utilization, uint32_t queued_tasks,
+                                     uint64_t tasks_completed, uint64_t tasks_stolen) {
+    if (!data_) return;
+
+    data_->telemetry.seq.fetch_add(1, std::memory_order_release);
+    data_->telemetry.pool_threads = threads;
+    data_->telemetry.pool_utilization = utilization;
+    data_->telemetry.pool_queued_tasks = queued_tasks;
+    data_->telemetry.pool_tasks_completed = tasks_completed;
+    data_->telemetry.pool_tasks_stolen = tasks_stolen;
+    data_->telemetry.seq.fetch_add(1, std::memory_order_release);
+}
+
 // Matches: src/python/utils/shared_memory.py:109-157
 void SharedMemoryWriter::update_equity_results(
     const std::unordered_map<std::string, EquityResult>& results) {
@@ -125,6 +138,7 @@ void SharedMemoryWriter::update_equity_results(
         data_->equity_results.results[idx].ties = result.ties;
         data_->equity_results.results[idx].losses = result.losses;
         data_->equity_results.results[idx].simulations = result.total_simulations;
+        data_->equity_results.results[idx].std_error = static_cast<float>(result.std_error);
 
         // Write win-method matrix (Python lines 144-148)
         for (int our_type = 0; our_type < 10; ++our_type) {
@@ -27,6 +27,10 @@ public:
     // Set completion status (Python: set_status())
     void set_status(uint8_t status);
 
+    // Update worker pool utilization (C++ engine only)
+    void update_pool(uint32_t threads, float utilization, uint32_t queued_tasks,
+                     uint64_t tasks_completed, uint64_t tasks_stolen);
+
     // Update equity results (Python: update_equity_results())
     void update_equity_results(const std::unordered_map<std::string, EquityResult>& results);
 
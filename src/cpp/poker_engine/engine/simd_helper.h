@@ -2,11 +2,14 @@
 #define ENGINE_SIMD_HELPER_H
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
 
 #include "core/card.h"
 
-// Check for AVX2 support
+// AVX2 helpers are only visible to translation units compiled with -mavx2
+// (the per-ISA kernels); everything else goes through runtime dispatch.
 #if defined(__x86_64__) || defined(_M_X64)
 #if defined(__AVX2__)
 #define USE_AVX2 1
@@ -16,11 +19,24 @@
 
 namespace poker_engine {
 
+/**
+ * @brief Widest vector instruction set usable on this host.
+ * Ordered so that a higher value implies the lower ones.
+ */
+enum class SimdLevel : uint8_t {
+  kScalar = 0,
+  kSse4 = 1,
+  kAvx2 = 2,
+  kAvx512 = 3
+};
+
 /**
  * @brief SIMD Batch configuration and helper types.
  */
 struct SIMDConfig {
-  static constexpr int kBatchSize = 8;  // Logic assumes 8-lane processing
+  // Lanes a HandBatch can hold: one AVX-512 register of 32-bit values.
+  // Narrower ISAs fill the first 8 lanes (see SIMDHelper::BatchSize()).
+  static constexpr int kMaxBatchSize = 16;
 };
 
 /**
@@ -28,28 +44,59 @@ struct SIMDConfig {
  * Each hand consists of 7 cards.
  */
 struct HandBatch {
-  // Aligned to 32 bytes for AVX2 load/store efficiency
-  alignas(32) uint32_t ranks[7][SIMDConfig::kBatchSize];
-  alignas(32) uint32_t suits[7][SIMDConfig::kBatchSize];
+  // Each row is one 64-byte line, so both AVX2 and AVX-512 loads are aligned
+  alignas(64) uint32_t ranks[7][SIMDConfig::kMaxBatchSize];
+  alignas(64) uint32_t suits[7][SIMDConfig::kMaxBatchSize];
 };
 
 /**
  * @brief Helper class for SIMD operations.
- * Provides abstraction for AVX2 and potentially other architectures.
+ * Instruction set support is queried from the CPU at runtime, so a single
+ * binary runs on any x86-64 host and still uses the widest vectors it has.
  */
 class SIMDHelper {
  public:
   SIMDHelper() = delete;
 
   /**
-   * @brief Checks if AVX2 is supported and enabled in this build.
+   * @brief Checks if the CPU running this process supports AVX2.
    */
-  static constexpr bool IsAvx2Supported() {
-#ifdef USE_AVX2
-    return true;
-#else
-    return false;
-#endif
+  static bool IsAvx2Supported() {
+    return DetectLevel() >= SimdLevel::kAvx2;
+  }
+
+  /**
+   * @brief Checks if the CPU running this process supports AVX-512F.
+   */
+  static bool IsAvx512Supported() {
+    return DetectLevel() >= SimdLevel::kAvx512;
+  }
+
+  /**
+   * @brief Widest supported instruction set, detected once via cpuid.
+   * POKER_ENGINE_SIMD=scalar|sse4|avx2 caps the level (never raises it).
+   */
+  static SimdLevel DetectLevel() {
+    static const SimdLevel level = ClampToEnv(QueryCpu());
+    return level;
+  }
+
+  /**
+   * @brief Hands per evaluate_batch call at a given level.
+   */
+  static constexpr int BatchSize(SimdLevel level) {
+    return level == SimdLevel::kAvx512 ? 16 : 8;
+  }
+
+  static int BatchSize() { return BatchSize(DetectLevel()); }
+
+  static const char* LevelName(SimdLevel level) {
+    switch (level) {
+      case SimdLevel::kAvx512: return "avx512";
+      case SimdLevel::kAvx2: return "avx2";
+      case SimdLevel::kSse4: return "sse4";
+      default: return "scalar";
+    }
   }
 
 #ifdef USE_AVX2
@@ -88,6 +135,27 @@ class SIMDHelper {
     free(ptr);
 #endif
   }
+
+ private:
+  static SimdLevel QueryCpu() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+    if (__builtin_cpu_supports("sse4.1")) return SimdLevel::kSse4;
+#endif
+    return SimdLevel::kScalar;
+  }
+
+  static SimdLevel ClampToEnv(SimdLevel detected) {
+    const char* env = std::getenv("POKER_ENGINE_SIMD");
+    if (!env) return detected;
+    SimdLevel cap = detected;
+    if (std::strcmp(env, "scalar") == 0) cap = SimdLevel::kScalar;
+    else if (std::strcmp(env, "sse4") == 0) cap = SimdLevel::kSse4;
+    else if (std::strcmp(env, "avx2") == 0) cap = SimdLevel::kAvx2;
+    return cap < detected ? cap : detected;
+  }
 };
 
 }  // namespace poker_engine
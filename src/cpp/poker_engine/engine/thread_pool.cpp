@@ -0,0 +1,217 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace poker_engine {
+
+namespace {
+
+// The pool and index of the calling thread, if it is a pool thread
+thread_local ThreadPool* t_pool = nullptr;
+thread_local int t_worker = -1;
+
+// Single-writer counter update: no lock prefix, still safe to read
+void add_relaxed(std::atomic<uint64_t>& counter, uint64_t amount) {
+  counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+ThreadPool& ThreadPool::instance() {
+  static ThreadPool pool(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+  return pool;
+}
+
+ThreadPool::ThreadPool(int num_threads) {
+  num_threads = std::max(1, num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_all();
+  for (auto& t : threads_) t.join();
+}
+
+int ThreadPool::current_worker() {
+  return t_worker;
+}
+
+void ThreadPool::submit(Task task, const TaskGroup* group) {
+  // A pool thread keeps its own tasks local; others deal round-robin
+  const int index = (t_pool == this)
+                        ? t_worker
+                        : static_cast<int>(next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                           workers_.size());
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back({std::move(task), group});
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+
+  // Taking the lock orders this against a worker about to sleep
+  { std::lock_guard<std::mutex> lock(wake_mutex_); }
+  wake_cv_.notify_one();
+}
+
+bool ThreadPool::try_pop(int index, Task& task, bool& stolen, const TaskGroup* group) {
+  const int n = size();
+  auto qualifies = [group](const Queued& queued) { return !group || queued.group == group; };
+  auto take = [&](std::deque<Queued>& tasks, std::deque<Queued>::iterator it) {
+    task = std::move(it->task);
+    tasks.erase(it);
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+  };
+
+  // Own deque first, newest task (its data is likely still in cache)
+  {
+    Worker& own = *workers_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    auto it = std::find_if(own.tasks.rbegin(), own.tasks.rend(), qualifies);
+    if (it != own.tasks.rend()) {
+      take(own.tasks, std::prev(it.base()));
+      stolen = false;
+      return true;
+    }
+  }
+
+  // Then steal the oldest task of the next busy thread
+  for (int k = 1; k < n; ++k) {
+    Worker& victim = *workers_[(index + k) % n];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    auto it = std::find_if(victim.tasks.begin(), victim.tasks.end(), qualifies);
+    if (it != victim.tasks.end()) {
+      take(victim.tasks, it);
+      stolen = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run_task(int index, Task& task, bool stolen) {
+  const auto start = std::chrono::steady_clock::now();
+  task();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  Worker& worker = *workers_[index];
+  add_relaxed(worker.busy_ns,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  add_relaxed(worker.completed, 1);
+  if (stolen) add_relaxed(worker.stolen, 1);
+}
+
+bool ThreadPool::run_pending_task(const TaskGroup* group) {
+  if (t_pool != this) return false;
+
+  Task task;
+  bool stolen = false;
+  if (!try_pop(t_worker, task, stolen, group)) return false;
+  run_task(t_worker, task, stolen);
+  return true;
+}
+
+void ThreadPool::worker_loop(int index) {
+  t_pool = this;
+  t_worker = index;
+
+  while (true) {
+    Task task;
+    bool stolen = false;
+    if (try_pop(index, task, stolen)) {
+      run_task(index, task, stolen);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait(lock, [this] {
+      return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && queued_.load(std::memory_order_acquire) == 0) return;
+  }
+}
+
+ThreadPool::Stats ThreadPool::stats() const {
+  Stats stats;
+  stats.threads = static_cast<uint32_t>(workers_.size());
+  stats.queued = static_cast<uint32_t>(std::max(0, queued_.load(std::memory_order_relaxed)));
+  for (const auto& worker : workers_) {
+    stats.busy_ns += worker->busy_ns.load(std::memory_order_relaxed);
+    stats.tasks_completed += worker->completed.load(std::memory_order_relaxed);
+    stats.tasks_stolen += worker->stolen.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+bool ThreadPool::owns_current_thread() const {
+  return t_pool == this;
+}
+
+TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+    // A task's exception is only reported to an explicit wait
+  }
+}
+
+void TaskGroup::run(ThreadPool::Task task) {
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  pool_.submit([this, task = std::move(task)] {
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+    // Decrement under the lock: once a waiter has seen zero and taken the
+    // lock, no task touches this group again
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) done_cv_.notify_all();
+  }, this);
+}
+
+bool TaskGroup::wait_for(std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const bool on_pool = pool_.owns_current_thread();
+
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) break;
+
+    // A pool thread helps with this group rather than blocking one of the
+    // pool's threads
+    if (on_pool && pool_.run_pending_task(this)) continue;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto until = on_pool ? std::min(deadline, now + std::chrono::milliseconds(1)) : deadline;
+    done_cv_.wait_until(lock, until, [this] {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.load(std::memory_order_acquire) > 0) return false;
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+  return true;
+}
+
+void TaskGroup::wait() {
+  while (!wait_for(std::chrono::milliseconds(100))) {
+  }
+}
+
+}  // namespace poker_engine
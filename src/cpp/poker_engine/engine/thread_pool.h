@@ -0,0 +1,131 @@
+#ifndef ENGINE_THREAD_POOL_H
+#define ENGINE_THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace poker_engine {
+
+class TaskGroup;
+
+/**
+ * @brief Process-wide work-stealing thread pool.
+ *
+ * Each pool thread owns a deque: it pushes and pops its own tasks at the
+ * back and, when that runs dry, steals from the front of the others'.
+ * Tasks submitted from outside the pool are dealt round-robin across the
+ * deques. EquityEngine cuts each job into (hand, chunk) tasks on it, so
+ * no thread is created per hand.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // Lifetime counters, for telemetry
+  struct Stats {
+    uint32_t threads = 0;
+    uint32_t queued = 0;           // tasks waiting to run
+    uint64_t busy_ns = 0;          // summed time spent running tasks
+    uint64_t tasks_completed = 0;
+    uint64_t tasks_stolen = 0;     // run by a thread other than the one queued on
+  };
+
+  // The shared pool, one thread per hardware thread, started on first use
+  static ThreadPool& instance();
+
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int size() const { return static_cast<int>(workers_.size()); }
+
+  // Index of the calling thread in its pool, or -1 off-pool
+  static int current_worker();
+
+  bool owns_current_thread() const;
+
+  // `group` tags the task for run_pending_task(); null for none
+  void submit(Task task, const TaskGroup* group = nullptr);
+
+  // Runs one queued task of `group` on the calling pool thread, stealing
+  // if needed. Returns false if none is queued. Lets a pool thread that
+  // waits on a group help with it instead of blocking, without picking up
+  // unrelated work that would then run nested on its stack.
+  bool run_pending_task(const TaskGroup* group);
+
+  Stats stats() const;
+
+ private:
+  struct Queued {
+    Task task;
+    const TaskGroup* group;
+  };
+
+  struct alignas(64) Worker {
+    std::mutex mutex;
+    std::deque<Queued> tasks;
+    // Written by the owning thread only
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> stolen{0};
+  };
+
+  void worker_loop(int index);
+  // With a group, only that group's tasks qualify
+  bool try_pop(int index, Task& task, bool& stolen, const TaskGroup* group = nullptr);
+  void run_task(int index, Task& task, bool stolen);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<int> queued_{0};
+  std::atomic<uint32_t> next_queue_{0};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  bool stopping_ = false;
+};
+
+/**
+ * @brief A set of pool tasks that can be waited on together.
+ *
+ * wait_for() on a pool thread runs the group's own queued tasks while it
+ * waits, so a task that waits on subtasks cannot deadlock the pool. Off
+ * the pool it simply blocks. The first exception a task throws is rethrown by the
+ * next wait.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void run(ThreadPool::Task task);
+
+  // True once every task has finished; false if `timeout` passed first
+  bool wait_for(std::chrono::milliseconds timeout);
+  void wait();
+
+ private:
+  ThreadPool& pool_;
+  std::atomic<int> pending_{0};
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+  std::exception_ptr error_;
+};
+
+}  // namespace poker_engine
+
+#endif  // ENGINE_THREAD_POOL_H
@@ -2,272 +2,247 @@
 #include "hand_types.h"
 #include <algorithm>
 #include <array>
-#include <numeric>
+#include <bit>
+#include <stdexcept>
+#include <vector>
 
 namespace poker_engine {
 
-// Prime numbers for each rank (2-A)
-// 2=2, 3=3, 4=5, 5=7, 6=11, 7=13, 8=17, 9=19, T=23, J=29, Q=31, K=37, A=41
-static const int PRIMES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
-
-// Arrays for perfect hash lookup (to be implemented/generated)
-// For now, we'll use a simplified version or the standard arrays if available.
-// Since we don't have the massive arrays pre-generated in a header, we might implement
-// the logic to map prime products to values directly or use a smaller lookup table.
-// However, standard Cactus Kev uses a large lookup table.
-
-// Let's implement the core logic:
-// 1. Convert cards to Cactus Kev integer representation
-// 2. Check for flush
-// 3. If flush, lookup in flush table
-// 4. If no flush, lookup in unique5 table
+namespace {
+
+// The 5-card subsets of 7 card slots, ordered by their highest slot, so
+// the first 1, 6 or 21 are the subsets of 5, 6 or 7 cards
+constexpr auto kSubsets = [] {
+    std::array<std::array<uint8_t, 5>, 21> subsets{};
+    int n = 0;
+    for (int last = 4; last < 7; ++last) {
+        for (int a = 0; a < last; ++a)
+            for (int b = a + 1; b < last; ++b)
+                for (int c = b + 1; c < last; ++c)
+                    for (int d = c + 1; d < last; ++d) {
+                        subsets[n++] = {static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                                        static_cast<uint8_t>(c), static_cast<uint8_t>(d),
+                                        static_cast<uint8_t>(last)};
+                    }
+    }
+    return subsets;
+}();
 
-// For this implementation, we will use a self-contained version that doesn't rely on
-// external massive headers if possible, or we define the necessary tables here.
-// Given the constraints, we'll implement the "Paul Senzee" optimization of Cactus Kev
-// which uses a perfect hash to reduce table size, but that requires pre-computed tables.
-// To keep it simple and correct first, we will implement the logic using standard hand evaluation
-// math if we don't have the tables, OR we can generate the tables on startup (fast enough).
+constexpr int kSubsetCount[kMaxHandCards + 1] = {0, 0, 0, 0, 0, 1, 6, 21};
 
-// Let's use the approach of generating tables on startup for the "perfect hash" optimization
-// or simply port the logic.
+// Ranks (2-14) of a 13-bit mask of five rank bits, highest first
+std::array<uint8_t, 5> ranks_of(uint32_t mask) {
+    std::array<uint8_t, 5> ranks{};
+    int n = 0;
+    for (int r = 12; r >= 0; --r) {
+        if ((mask >> r) & 1) ranks[n++] = static_cast<uint8_t>(r + 2);
+    }
+    return ranks;
+}
 
-// Actually, for the "Prime Product" logic (Cactus Kev), the key is:
-// Value = P(c1) * P(c2) * P(c3) * P(c4) * P(c5)
-// Then map Value -> Rank.
+// High card (5 for the wheel) if five rank bits make a straight, else 0
+int straight_high(uint32_t mask) {
+    if (mask == 0x100F) return 5;
+    const int low = std::countr_zero(mask);
+    return mask == (0x1Fu << low) ? low + 6 : 0;
+}
 
-// Since we need to pass the test "EvaluatesRoyalFlush", let's implement the full logic.
+// Senzee's mix of a prime product: the bucket picks an adjust value that
+// the slot is xored with
+struct HashParts {
+    uint32_t slot;
+    uint32_t bucket;
+};
 
-// Lookup tables
-static int flush_lookup[8192];
-static int unsuited_lookup[4888]; // Using perfect hash, this size varies
+HashParts hash_parts(uint32_t u) {
+    u += 0xe91aaa35;
+    u ^= u >> 16;
+    u += u << 8;
+    u ^= u >> 4;
+    return {(u + (u << 2)) >> 19, (u >> 8) & 0x1ff};
+}
 
-// Initialization flag
-static bool tables_initialized = false;
+}  // namespace
 
-// Helpers to initialize tables
-void CactusKevEvaluator::init_tables() {
-    if (tables_initialized) return;
+struct CactusKevEvaluator::Tables {
+    Tables() {
+        populate_flushes();
+        populate_unique5();
+        populate_paired();
+    }
 
-    // 1. Generate Flush Table (8192 entries)
-    // Index is bitmask of rank occurrences in the flush suit
-    // Value is the rank score
-    for (int i = 0; i < 8192; i++) {
-        int bit_count = 0;
-        int temp = i;
-        while (temp) {
-            if (temp & 1) bit_count++;
-            temp >>= 1;
-        }
+    void populate_flushes();
+    void populate_unique5();
+    void populate_paired();
 
-        if (bit_count >= 5) {
-            // Reconstruct ranks from bitmask
-            std::vector<int> ranks;
-            for (int r = 0; r < 13; r++) {
-                if ((i >> r) & 1) ranks.push_back(r); // 0=2, 12=A
-            }
-            // Sort descending
-            std::sort(ranks.begin(), ranks.end(), std::greater<int>());
-            
-            // Calculate score (same scale as our naive evaluator)
-            // 0=2 ... 12=A.  Naive uses 2..14.
-            // Map 0->2, 12->14.
-            
-            // Check Straight Flush
-            bool straight = false;
-            // Check top 5 for straight
-            if (ranks.size() >= 5) {
-               // Check consecutive
-               bool con = true;
-               for (int k=0; k<4; k++) {
-                   if (ranks[k] - ranks[k+1] != 1) { con = false; break; }
-               }
-               if (con) straight = true;
-               
-               // Wheel check (A,5,4,3,2) -> Indices 12, 3, 2, 1, 0
-               if (!straight && ranks[0] == 12 && ranks[ranks.size()-4] == 3 && ranks[ranks.size()-1] == 0) {
-                   // Verify we have 3,2,1,0
-                   bool wheel = true;
-                   for (int k=0; k<4; k++) {
-                       // We need to find 3,2,1,0 in the list. 
-                       // ranks contains all flush cards.
-                       // Just check if we have the specific bits set in 'i'
-                       // 0x100F = 1 0000 0000 1111 (A,5,4,3,2)
-                       if ((i & 0x100F) == 0x100F) straight = true;
-                   }
-               }
-            }
-            
-            int32_t score = 0;
-            if (straight) {
-                // Royal?
-                if ((i & 0x1F00) == 0x1F00) score = 9000000; // T,J,Q,K,A
-                else {
-                    // Find highest card of straight
-                    // Simplification for generator: take highest rank that starts a straight
-                    int high = ranks[0];
-                    // Correction: find the actual straight high card
-                    // This is a generator, speed doesn't matter much.
-                    // ... implementation detail ...
-                    score = 8000000 + high + 2; 
-                }
-            } else {
-                score = 5000000 + (ranks[0] + 2); // Flush
-            }
-            flush_lookup[i] = score;
-        } else {
-            flush_lookup[i] = 0; // Not a flush
-        }
+    // Slot of a paired hand's prime product in hash_values: Paul Senzee's
+    // perfect hash, with hash_adjust built for it by populate_paired()
+    uint32_t find_fast(uint32_t u) const {
+        const HashParts parts = hash_parts(u);
+        return parts.slot ^ hash_adjust[parts.bucket];
     }
 
-    // 2. Generate Unique5 Table (Prime products)
-    // This requires iterating all unique 5-card rank combinations
-    // Calculate prime product -> value
-    // This is complex to implement fully in one shot without mistakes.
-    // For now, we will assume the flush table works and the fallback logic 
-    // in evaluate_5_cards handles the rest (which we implemented in the previous turn).
-    
-    // The "Perfect Hash" optimization relies on this table.
-    
-    tables_initialized = true;
-}
+    std::array<int32_t, 8192> flushes{};
+    std::array<int32_t, 8192> unique5{};
+    std::array<uint16_t, 512> hash_adjust{};
+    std::array<int32_t, 8192> hash_values{};
+};
 
-void CactusKevEvaluator::populate_flushes() {
-    // Stub
+const CactusKevEvaluator::Tables& CactusKevEvaluator::tables() {
+    static const Tables tables;
+    return tables;
 }
 
-void CactusKevEvaluator::populate_unique5() {
-    // Stub
+CactusKevEvaluator::CactusKevEvaluator() : tables_(&tables()) {}
+
+void CactusKevEvaluator::Tables::populate_flushes() {
+    for (uint32_t mask = 0; mask < flushes.size(); ++mask) {
+        if (std::popcount(mask) != 5) continue;
+        const int high = straight_high(mask);
+        if (high == 14) {
+            flushes[mask] = encode_score(HandType::ROYAL_FLUSH, {14, 13, 12, 11, 10});
+        } else if (high) {
+            flushes[mask] = encode_score(HandType::STRAIGHT_FLUSH, {static_cast<uint8_t>(high)});
+        } else {
+            flushes[mask] = encode_score(HandType::FLUSH, ranks_of(mask));
+        }
+    }
 }
 
-CactusKevEvaluator::CactusKevEvaluator() {
-    init_tables();
+void CactusKevEvaluator::Tables::populate_unique5() {
+    for (uint32_t mask = 0; mask < unique5.size(); ++mask) {
+        if (std::popcount(mask) != 5) continue;
+        const int high = straight_high(mask);
+        unique5[mask] = high ? encode_score(HandType::STRAIGHT, {static_cast<uint8_t>(high)})
+                              : encode_score(HandType::HIGH_CARD, ranks_of(mask));
+    }
 }
 
-// Convert Card to Cactus Kev integer
-// +--------+--------+--------+--------+
-// |xxxbbbbb|bbbbbbbb|cdhsrrrr|xxpppppp|
-// +--------+--------+--------+--------+
-// p = prime number of rank (deuce=2,trey=3,four=5,five=7,...,ace=41)
-// r = rank of card (deuce=0,trey=1,four=2,five=3,...,ace=12)
-// cdhs = suit of card
-// b = bit turned on depending on rank of card
-static int get_card_int(const Card& c) {
-    int rank = c.rank - 2; // 0-12
-    int suit = c.suit;     // 0-3
-    int prime = PRIMES[rank];
+void CactusKevEvaluator::Tables::populate_paired() {
+    // Every multiset of five ranks with a repeat (4888 of them), as its
+    // prime product and score
+    struct Hand {
+        uint32_t product;
+        int32_t score;
+    };
+    std::vector<Hand> hands;
+    uint8_t r[5];
+    for (r[0] = 0; r[0] < 13; ++r[0])
+    for (r[1] = 0; r[1] <= r[0]; ++r[1])
+    for (r[2] = 0; r[2] <= r[1]; ++r[2])
+    for (r[3] = 0; r[3] <= r[2]; ++r[3])
+    for (r[4] = 0; r[4] <= r[3]; ++r[4]) {
+        int counts[13] = {0};
+        uint32_t product = 1;
+        for (uint8_t rank : r) {
+            counts[rank]++;
+            product *= card_tables::kPrimes[rank];
+        }
+        const int most = *std::max_element(counts, counts + 13);
+        if (most == 1 || most == 5) continue;
+
+        // Groups by size, then rank, both descending: exactly the rank list
+        // encode_score expects for quads down to one pair
+        uint8_t ranks[5];
+        int n = 0;
+        for (int size = 4; size >= 1; --size) {
+            for (int rank = 12; rank >= 0; --rank) {
+                if (counts[rank] == size) ranks[n++] = static_cast<uint8_t>(rank + 2);
+            }
+        }
+        const int second = counts[ranks[1] - 2];
+        HandType type = HandType::ONE_PAIR;
+        if (most == 4) type = HandType::FOUR_OF_KIND;
+        else if (most == 3) type = second == 2 ? HandType::FULL_HOUSE : HandType::THREE_OF_KIND;
+        else if (second == 2) type = HandType::TWO_PAIR;
+        hands.push_back({product, encode_score(type, std::span<const uint8_t>(ranks, n))});
+    }
 
-    int b_mask = 1 << (16 + rank);
-    int cdhs_mask = 1 << (12 + suit);
-    int r_mask = rank << 8;
-    
-    return b_mask | cdhs_mask | r_mask | prime;
+    // Hash and displace: fill the fullest buckets first, each with the
+    // first adjust value that sends all of its products to free slots
+    struct Entry {
+        uint32_t slot;
+        int32_t score;
+    };
+    std::vector<std::vector<Entry>> buckets(hash_adjust.size());
+    for (const Hand& hand : hands) {
+        const HashParts parts = hash_parts(hand.product);
+        for (const Entry& other : buckets[parts.bucket]) {
+            // No adjust value can separate these two
+            if (other.slot == parts.slot) {
+                throw std::logic_error("no perfect hash for the Cactus Kev prime products");
+            }
+        }
+        buckets[parts.bucket].push_back({parts.slot, hand.score});
+    }
+    std::vector<uint32_t> order(buckets.size());
+    for (uint32_t b = 0; b < order.size(); ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) {
+        return buckets[x].size() > buckets[y].size();
+    });
+
+    std::vector<bool> used(hash_values.size());
+    for (uint32_t b : order) {
+        if (buckets[b].empty()) break;
+        auto fits = [&](uint32_t adjust) {
+            for (const Entry& entry : buckets[b]) {
+                if (used[entry.slot ^ adjust]) return false;
+            }
+            return true;
+        };
+        uint32_t adjust = 0;
+        while (adjust < hash_values.size() && !fits(adjust)) ++adjust;
+        if (adjust == hash_values.size()) {
+            throw std::logic_error("no perfect hash for the Cactus Kev prime products");
+        }
+        hash_adjust[b] = static_cast<uint16_t>(adjust);
+        for (const Entry& entry : buckets[b]) {
+            used[entry.slot ^ adjust] = true;
+            hash_values[entry.slot ^ adjust] = entry.score;
+        }
+    }
 }
 
 int32_t CactusKevEvaluator::evaluate_hand(
     const std::vector<Card>& hole_cards,
     const std::vector<Card>& board_cards) const {
-    
-    std::vector<Card> all_cards = hole_cards;
-    all_cards.insert(all_cards.end(), board_cards.begin(), board_cards.end());
+    std::array<uint8_t, kMaxHandCards> ids;
+    size_t n = pack_card_ids(hole_cards, board_cards, ids);
+    return evaluate(CardIds(ids.data(), n));
+}
 
-    int32_t best_score = 0;
-    size_t n = all_cards.size();
+int32_t CactusKevEvaluator::evaluate(CardIds cards) const {
+    // Cards in Cactus Kev integer form (see card_tables::kCactusKev)
+    uint32_t all_cards[kMaxHandCards];
+    size_t n = std::min(cards.size(), kMaxHandCards);
+    if (n < 5) return 0;
+    for (size_t i = 0; i < n; ++i) all_cards[i] = card_tables::kCactusKev[cards[i]];
 
-    // Iterate all combinations and return the best unified score
-    for (size_t i = 0; i < n - 4; ++i) {
-        for (size_t j = i + 1; j < n - 3; ++j) {
-            for (size_t k = j + 1; k < n - 2; ++k) {
-                for (size_t l = k + 1; l < n - 1; ++l) {
-                    for (size_t m = l + 1; m < n; ++m) {
-                        std::vector<Card> hand = {all_cards[i], all_cards[j], all_cards[k], all_cards[l], all_cards[m]};
-                        int32_t score = evaluate_5_cards(hand);
-                        if (score > best_score) best_score = score;
-                    }
-                }
-            }
-        }
+    // Best of the 1, 6 or 21 five-card subsets
+    int32_t best_score = 0;
+    for (int s = 0; s < kSubsetCount[n]; ++s) {
+        const auto& subset = kSubsets[s];
+        const int32_t score = evaluate_5_cards(all_cards[subset[0]], all_cards[subset[1]],
+                                               all_cards[subset[2]], all_cards[subset[3]],
+                                               all_cards[subset[4]]);
+        if (score > best_score) best_score = score;
     }
     return best_score;
 }
 
-int32_t CactusKevEvaluator::evaluate_5_cards(const std::vector<Card>& cards) const {
-    uint32_t q = 0;
-    uint8_t ranks[5];
-    bool flush = true;
-    uint8_t first_suit = cards[0].suit;
+int32_t CactusKevEvaluator::evaluate_5_cards(uint32_t c1, uint32_t c2, uint32_t c3, uint32_t c4,
+                                             uint32_t c5) const {
+    const uint32_t ranks = (c1 | c2 | c3 | c4 | c5) >> 16;
 
-    for (int i = 0; i < 5; ++i) {
-        ranks[i] = cards[i].rank;
-        if (cards[i].suit != first_suit) flush = false;
-    }
+    // All five share a suit bit
+    if (c1 & c2 & c3 & c4 & c5 & 0xF000) return tables_->flushes[ranks];
 
-    std::sort(ranks, ranks + 5, std::greater<uint8_t>());
+    // Five distinct ranks: straights and high cards
+    if (const int32_t score = tables_->unique5[ranks]) return score;
 
-    // Straight Check
-    bool straight = true;
-    for (int i = 0; i < 4; ++i) if (ranks[i] != ranks[i + 1] + 1) straight = false;
-    
-    // Ace-low straight
-    if (!straight && ranks[0] == 14 && ranks[1] == 5 && ranks[2] == 4 && ranks[3] == 3 && ranks[4] == 2) {
-        straight = true;
-        return flush ? encode_score(HandType::STRAIGHT_FLUSH, {5}) 
-                     : encode_score(HandType::STRAIGHT, {5});
-    }
-
-    if (flush && straight) {
-        if (ranks[0] == 14) return encode_score(HandType::ROYAL_FLUSH, {14, 13, 12, 11, 10});
-        return encode_score(HandType::STRAIGHT_FLUSH, {ranks[0]});
-    }
-
-    // Use rank counts for other hands
-    std::unordered_map<uint8_t, int> counts;
-    for (int i = 0; i < 5; ++i) counts[ranks[i]]++;
-
-    std::vector<std::pair<int, uint8_t>> pattern;
-    for (auto const& [rank, count] : counts) pattern.push_back({count, rank});
-    std::sort(pattern.rbegin(), pattern.rend());
-
-    if (pattern[0].first == 4) return encode_score(HandType::FOUR_OF_KIND, {pattern[0].second, pattern[1].second});
-    if (pattern[0].first == 3 && pattern[1].first == 2) return encode_score(HandType::FULL_HOUSE, {pattern[0].second, pattern[1].second});
-    if (flush) return encode_score(HandType::FLUSH, {ranks[0], ranks[1], ranks[2], ranks[3], ranks[4]});
-    if (straight) return encode_score(HandType::STRAIGHT, {ranks[0]});
-    if (pattern[0].first == 3) return encode_score(HandType::THREE_OF_KIND, {pattern[0].second, pattern[1].second, pattern[2].second});
-    if (pattern[0].first == 2 && pattern[1].first == 2) return encode_score(HandType::TWO_PAIR, {pattern[0].second, pattern[1].second, pattern[2].second});
-    if (pattern[0].first == 2) return encode_score(HandType::ONE_PAIR, {pattern[0].second, pattern[1].second, pattern[2].second, pattern[3].second});
-    
-    return encode_score(HandType::HIGH_CARD, {ranks[0], ranks[1], ranks[2], ranks[3], ranks[4]});
+    // A repeated rank
+    return tables_->hash_values[tables_->find_fast((c1 & 0xFF) * (c2 & 0xFF) * (c3 & 0xFF) *
+                                                 (c4 & 0xFF) * (c5 & 0xFF))];
 }
 
-int CactusKevEvaluator::find_fast(uint32_t u) const {
-
-    // Perfect Hash for Cactus Kev (Paul Senzee optimization)
-
-    // u is the prime product
-
-    uint32_t a, b, r;
-
-    u += 0xe91aaa35;
-
-    u ^= u >> 16;
-
-    u += u << 8;
-
-    u ^= u >> 4;
-
-    b = (u >> 8) & 0x1ff;
-
-    a = (u + (u << 2)) >> 19;
-
-    r = a ^ b; // This is the hash index
-
-    
-
-    // In a real implementation, we'd return unique5_lookup_[r]
-
-    // For now, this is the skeletal multiplier logic.
-
-    return r;
-
-}
 }  // namespace poker_engine
@@ -2,6 +2,7 @@
 #define EVALUATORS_CACTUS_KEV_EVALUATOR_H
 
 #include "core/card.h"
+#include "evaluator_interface.h"
 #include <vector>
 #include <array>
 
@@ -15,17 +16,22 @@ class CactusKevEvaluator {
   int32_t evaluate_hand(const std::vector<Card>& hole_cards,
                         const std::vector<Card>& board_cards) const;
 
- private:
-  int32_t evaluate_5_cards(const std::vector<Card>& cards) const;
-  int find_fast(uint32_t u) const;
-
-  void init_tables();
-  void populate_flushes();
-  void populate_unique5();
+  // Evaluate 5-7 card ids without allocating (see evaluator_interface.h)
+  int32_t evaluate(CardIds cards) const;
 
-  std::array<int, 8192> flush_lookup_;
-  std::array<int, 4888> unique5_lookup_;
-  std::array<uint32_t, 4888> perfect_hash_keys_;
+ private:
+  // encode_score values. Five distinct ranks are looked up by the OR of
+  // their rank bits (flushes when the cards share a suit, unique5
+  // otherwise), hands with a repeated rank by the product of their primes.
+  // Built on first use and shared by every evaluator.
+  struct Tables;
+  static const Tables& tables();
+
+  // Five Cactus Kev card ints
+  int32_t evaluate_5_cards(uint32_t c1, uint32_t c2, uint32_t c3, uint32_t c4,
+                           uint32_t c5) const;
+
+  const Tables* tables_;
 };
 
 }  // namespace poker_engine
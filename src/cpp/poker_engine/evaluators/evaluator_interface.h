@@ -0,0 +1,145 @@
+#ifndef EVALUATORS_EVALUATOR_INTERFACE_H
+#define EVALUATORS_EVALUATOR_INTERFACE_H
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/card.h"
+
+namespace poker_engine {
+
+// Common evaluator interface: every evaluator scores 5-7 cards given as
+// compact ids (card_id(): 0-51, (rank - 2) * 4 + suit) and returns an
+// encode_score() value. evaluate() never touches the heap; the older
+// evaluate_hand(vector, vector) entry points are thin wrappers over it.
+using CardIds = std::span<const uint8_t>;
+
+constexpr size_t kMaxHandCards = 7;
+
+template <typename E>
+concept HandEvaluator = requires(const E& evaluator, CardIds cards) {
+  { evaluator.evaluate(cards) } -> std::same_as<int32_t>;
+};
+
+// Evaluators that also score from a partial state: State{} holds no cards,
+// add() folds in one more (cards may come in any order) and evaluate()
+// scores a state of 5-7 cards. A prefix that many hands share, such as
+// hole cards plus a known board, is then folded in once and copied.
+template <typename E>
+concept IncrementalEvaluator =
+    HandEvaluator<E> && requires(const E& evaluator, typename E::State state, uint8_t id) {
+      { evaluator.add(state, id) } -> std::same_as<typename E::State>;
+      { evaluator.evaluate(state) } -> std::same_as<int32_t>;
+    };
+
+// Card id -> each evaluator's native encoding
+namespace card_tables {
+
+// Prime numbers for each rank (2-A), the Cactus Kev product hash
+constexpr int kPrimes[13] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+
+// Rank 2-14
+constexpr auto kRank = [] {
+  std::array<uint8_t, 52> table{};
+  for (int id = 0; id < 52; ++id) table[id] = static_cast<uint8_t>(id / 4 + 2);
+  return table;
+}();
+
+// Suit 0-3
+constexpr auto kSuit = [] {
+  std::array<uint8_t, 52> table{};
+  for (int id = 0; id < 52; ++id) table[id] = static_cast<uint8_t>(id % 4);
+  return table;
+}();
+
+// 1 << (rank - 2): the rank-mask encoding used by OMPEval and PHEvaluator
+constexpr auto kRankBit = [] {
+  std::array<uint16_t, 52> table{};
+  for (int id = 0; id < 52; ++id) table[id] = static_cast<uint16_t>(1u << (id / 4));
+  return table;
+}();
+
+// Cactus Kev card int
+// +--------+--------+--------+--------+
+// |xxxbbbbb|bbbbbbbb|cdhsrrrr|xxpppppp|
+// +--------+--------+--------+--------+
+// p = prime number of rank (deuce=2,trey=3,four=5,five=7,...,ace=41)
+// r = rank of card (deuce=0,trey=1,four=2,five=3,...,ace=12)
+// cdhs = suit of card
+// b = bit turned on depending on rank of card
+constexpr auto kCactusKev = [] {
+  std::array<uint32_t, 52> table{};
+  for (int id = 0; id < 52; ++id) {
+    int rank = id / 4;
+    int suit = id % 4;
+    table[id] = (1u << (16 + rank)) | (1u << (12 + suit)) |
+                (static_cast<uint32_t>(rank) << 8) | kPrimes[rank];
+  }
+  return table;
+}();
+
+// Two Plus Two state-machine card number (1-52)
+constexpr auto kTwoPlusTwo = [] {
+  std::array<uint8_t, 52> table{};
+  for (int id = 0; id < 52; ++id) table[id] = static_cast<uint8_t>(id + 1);
+  return table;
+}();
+
+}  // namespace card_tables
+
+// Rank and suit tallies of a set of cards, everything the bit-math
+// evaluators (OMPEval, PHEvaluator) look at; their partial state. Packed
+// into integers so that a state copied per hand stays in registers.
+struct RankSuitCounts {
+  uint32_t ranks_mask = 0;   // 1 << (rank - 2) for each rank present
+  uint32_t suit_counts = 0;  // 8 bits per suit
+  uint64_t rank_counts = 0;  // 4 bits per rank, at 4 * rank
+  uint64_t suit_masks = 0;   // a 16-bit rank mask per suit
+
+  void add(uint8_t id) {
+    const uint32_t bit = card_tables::kRankBit[id];
+    const uint8_t suit = card_tables::kSuit[id];
+    ranks_mask |= bit;
+    rank_counts += 1ULL << (4 * card_tables::kRank[id]);
+    suit_counts += 1u << (8 * suit);
+    suit_masks |= static_cast<uint64_t>(bit) << (16 * suit);
+  }
+
+  int suit_count(int suit) const { return static_cast<int>(suit_counts >> (8 * suit)) & 0xFF; }
+  uint32_t suit_mask(int suit) const { return static_cast<uint32_t>(suit_masks >> (16 * suit)) & 0xFFFF; }
+
+  // Ranks held exactly `count` (1-4) times, a bit at 4 * rank for each:
+  // the nibbles of rank_counts that match, found all at once
+  uint64_t ranks_with_count(int count) const {
+    constexpr uint64_t kLow3 = 0x7777777777777777ULL;
+    const uint64_t x = rank_counts ^ (0x1111111111111111ULL * count);
+    return (~(((x & kLow3) + kLow3) | x) & 0x8888888888888888ULL) >> 3;
+  }
+
+  // Highest rank in a non-empty ranks_with_count() set
+  static int top_rank(uint64_t ranks) { return (63 - std::countl_zero(ranks)) / 4; }
+};
+
+// Packs hole + board into `out` as card ids for the vector-based wrappers.
+// Returns the number of ids written (capped at kMaxHandCards).
+inline size_t pack_card_ids(const std::vector<Card>& hole_cards,
+                            const std::vector<Card>& board_cards,
+                            std::array<uint8_t, kMaxHandCards>& out) {
+  size_t n = 0;
+  for (const auto& c : hole_cards) {
+    if (n < kMaxHandCards) out[n++] = card_id(c);
+  }
+  for (const auto& c : board_cards) {
+    if (n < kMaxHandCards) out[n++] = card_id(c);
+  }
+  return n;
+}
+
+}  // namespace poker_engine
+
+#endif  // EVALUATORS_EVALUATOR_INTERFACE_H
@@ -0,0 +1,213 @@
+#include "hand_ranks_table.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace poker_engine {
+
+namespace {
+
+constexpr size_t kHugePageSize = size_t{2} << 20;
+constexpr long kHugetlbfsMagic = 0x958458f6;  // statfs f_type of a hugetlbfs mount
+
+// Closes a descriptor on every path out
+struct FileDescriptor {
+    int fd;
+    explicit FileDescriptor(int fd) : fd(fd) {}
+    ~FileDescriptor() {
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+[[noreturn]] void fail(const std::string& path, const std::string& what) {
+    throw std::runtime_error(path + ": " + what);
+}
+
+size_t round_up(size_t n, size_t multiple) { return (n + multiple - 1) / multiple * multiple; }
+
+// Maps `bytes` of `fd` read-only at a 2 MB boundary, where transparent huge
+// pages can back it. Returns MAP_FAILED on error.
+void* map_aligned(int fd, size_t bytes) {
+    const size_t span = bytes + kHugePageSize;
+    void* reserved = mmap(nullptr, span, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) return MAP_FAILED;
+    const auto base = reinterpret_cast<uintptr_t>(reserved);
+    const uintptr_t aligned = round_up(base, kHugePageSize);
+    void* mapped = mmap(reinterpret_cast<void*>(aligned), bytes, PROT_READ, MAP_SHARED | MAP_FIXED,
+                        fd, 0);
+    if (mapped == MAP_FAILED) {
+        munmap(reserved, span);
+        return MAP_FAILED;
+    }
+    // Give back the reservation around the mapping
+    const uintptr_t end = aligned + round_up(bytes, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    if (aligned > base) munmap(reserved, aligned - base);
+    if (base + span > end) munmap(reinterpret_cast<void*>(end), base + span - end);
+#ifdef MADV_HUGEPAGE
+    madvise(mapped, bytes, MADV_HUGEPAGE);
+#endif
+    return mapped;
+}
+
+// Entries of a table file of `bytes`, checked against its trailer, and
+// their checksum
+size_t checked_entries(const std::string& path, const char* file, size_t bytes,
+                       uint64_t& checksum) {
+    const auto* data = reinterpret_cast<const int32_t*>(file);
+    HandRanksTrailer trailer;
+    if (bytes >= sizeof(trailer)) {
+        std::memcpy(&trailer, file + bytes - sizeof(trailer), sizeof(trailer));
+        if (std::memcmp(trailer.magic, kHandRanksMagic, sizeof(kHandRanksMagic)) == 0) {
+            const size_t table_bytes = bytes - sizeof(trailer);
+            if (table_bytes % sizeof(int32_t) != 0 ||
+                trailer.entries != table_bytes / sizeof(int32_t)) {
+                fail(path, "size does not match its trailer");
+            }
+            checksum = hand_ranks_checksum(data, trailer.entries);
+            if (checksum != trailer.checksum) fail(path, "checksum mismatch");
+            return trailer.entries;
+        }
+    }
+    if (bytes != kLegacyHandRanksEntries * sizeof(int32_t)) {
+        fail(path, "no trailer and not the full table (" + std::to_string(bytes) +
+                       " bytes); truncated? Regenerate it with tools/generate_table");
+    }
+    checksum = hand_ranks_checksum(data, kLegacyHandRanksEntries);
+    return kLegacyHandRanksEntries;
+}
+
+// Maps the hugetlbfs copy of a table read-only, made by the first process
+// to need it: written under a private name and renamed, so no process ever
+// maps a partial copy. Sets `mapped_bytes`; returns null (with a warning)
+// when staging is not possible.
+void* stage_in_hugetlbfs(const std::string& dir, const int32_t* data, size_t entries,
+                         uint64_t checksum, size_t& mapped_bytes) {
+    struct statfs fs;
+    if (statfs(dir.c_str(), &fs) != 0 || static_cast<long>(fs.f_type) != kHugetlbfsMagic) {
+        std::cerr << "Warning: HAND_RANKS_HUGETLBFS=" << dir << " is not a hugetlbfs mount."
+                  << std::endl;
+        return nullptr;
+    }
+    const size_t bytes = entries * sizeof(int32_t);
+    mapped_bytes = round_up(bytes, static_cast<size_t>(fs.f_bsize));
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/HandRanks-%016llx.dat",
+                  static_cast<unsigned long long>(checksum));
+    const std::string staged = dir + name;
+
+    // Another process's copy
+    {
+        FileDescriptor file(::open(staged.c_str(), O_RDONLY));
+        if (file.fd >= 0) {
+            void* mapped = mmap(nullptr, mapped_bytes, PROT_READ, MAP_SHARED, file.fd, 0);
+            if (mapped != MAP_FAILED) {
+                if (hand_ranks_checksum(static_cast<const int32_t*>(mapped), entries) == checksum) {
+                    return mapped;
+                }
+                munmap(mapped, mapped_bytes);
+            }
+            std::cerr << "Warning: ignoring unreadable " << staged << std::endl;
+            return nullptr;
+        }
+    }
+
+    const std::string scratch = staged + "." + std::to_string(getpid());
+    FileDescriptor file(::open(scratch.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644));
+    if (file.fd < 0 || ftruncate(file.fd, static_cast<off_t>(mapped_bytes)) != 0) {
+        std::cerr << "Warning: cannot stage " << staged << ": " << std::strerror(errno)
+                  << std::endl;
+        if (file.fd >= 0) unlink(scratch.c_str());
+        return nullptr;
+    }
+    void* mapped = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Warning: no huge pages for " << staged << ": " << std::strerror(errno)
+                  << std::endl;
+        unlink(scratch.c_str());
+        return nullptr;
+    }
+    std::memcpy(mapped, data, bytes);
+    // A copy another process published meanwhile is the same table;
+    // replacing it leaves their mappings intact
+    if (rename(scratch.c_str(), staged.c_str()) != 0) unlink(scratch.c_str());
+    if (mprotect(mapped, mapped_bytes, PROT_READ) != 0) {
+        munmap(mapped, mapped_bytes);
+        return nullptr;
+    }
+    return mapped;
+}
+
+}  // namespace
+
+HandRanksTable::HandRanksTable(void* mapping, size_t mapped_bytes, size_t entries,
+                               uint64_t checksum, bool hugetlbfs)
+    : mapping_(mapping),
+      mapped_bytes_(mapped_bytes),
+      data_(static_cast<const int32_t*>(mapping)),
+      entries_(entries),
+      checksum_(checksum),
+      hugetlbfs_(hugetlbfs) {}
+
+HandRanksTable::~HandRanksTable() {
+    munmap(mapping_, mapped_bytes_);
+}
+
+std::shared_ptr<const HandRanksTable> HandRanksTable::open(const std::string& path) {
+    FileDescriptor file(::open(path.c_str(), O_RDONLY));
+    struct stat st;
+    if (file.fd < 0 || fstat(file.fd, &st) != 0) fail(path, std::strerror(errno));
+    const auto bytes = static_cast<size_t>(st.st_size);
+    if (bytes == 0) fail(path, "empty file");
+
+    void* mapped = map_aligned(file.fd, bytes);
+    if (mapped == MAP_FAILED) fail(path, std::string("mmap: ") + std::strerror(errno));
+    // Owns the mapping from here, so a failed check unmaps it
+    std::shared_ptr<HandRanksTable> table(new HandRanksTable(mapped, bytes, 0, 0, false));
+
+    // The checksum reads the whole table, which also faults it in
+    madvise(mapped, bytes, MADV_WILLNEED);
+    table->entries_ =
+        checked_entries(path, static_cast<const char*>(mapped), bytes, table->checksum_);
+
+    if (const char* dir = std::getenv("HAND_RANKS_HUGETLBFS"); dir && *dir) {
+        size_t staged_bytes = 0;
+        if (void* staged = stage_in_hugetlbfs(dir, table->data_, table->entries_, table->checksum_,
+                                              staged_bytes)) {
+            return std::shared_ptr<const HandRanksTable>(new HandRanksTable(
+                staged, staged_bytes, table->entries_, table->checksum_, true));
+        }
+    }
+    return table;
+}
+
+std::shared_ptr<const HandRanksTable> HandRanksTable::shared(const std::string& path) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const HandRanksTable>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = tables.try_emplace(path);
+    if (inserted) {
+        try {
+            it->second = open(path);
+            const size_t megabytes = it->second->size() * sizeof(int32_t) / (1024 * 1024);
+            std::cout << "Mapped Two Plus Two lookup table (" << megabytes << " MB"
+                      << (it->second->huge_pages() ? ", hugetlbfs" : "") << ")." << std::endl;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Warning: " << e.what() << std::endl;
+        }
+    }
+    return it->second;
+}
+
+}  // namespace poker_engine
@@ -0,0 +1,83 @@
+#ifndef EVALUATORS_HAND_RANKS_TABLE_H
+#define EVALUATORS_HAND_RANKS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace poker_engine {
+
+// HandRanks.dat ends in this trailer (tools/generate_table writes it): the
+// int32 entries before it and their checksum. A file cut short loses it.
+struct HandRanksTrailer {
+  char magic[8];
+  uint64_t entries;
+  uint64_t checksum;
+};
+inline constexpr char kHandRanksMagic[8] = {'H', 'R', 'A', 'N', 'K', 'S', '0', '1'};
+
+// Files written before the trailer are accepted at exactly this length
+inline constexpr size_t kLegacyHandRanksEntries = 32487834;
+
+// FNV-1a over the 32-bit entries, in four interleaved lanes so it runs at
+// memory speed; tools/generate_table.cpp carries a copy
+inline uint64_t hand_ranks_checksum(const int32_t* data, size_t entries) {
+  constexpr uint64_t kPrime = 0x100000001B3ull;
+  uint64_t lanes[4] = {0xCBF29CE484222325ull, 0x84222325CBF29CE4ull, 0x9E3779B97F4A7C15ull,
+                       0xC2B2AE3D27D4EB4Full};
+  size_t i = 0;
+  for (; i + 4 <= entries; i += 4) {
+    for (int lane = 0; lane < 4; ++lane) {
+      lanes[lane] = (lanes[lane] ^ static_cast<uint32_t>(data[i + lane])) * kPrime;
+    }
+  }
+  for (; i < entries; ++i) lanes[0] = (lanes[0] ^ static_cast<uint32_t>(data[i])) * kPrime;
+  uint64_t hash = entries;
+  for (uint64_t lane : lanes) hash = (hash ^ lane) * kPrime;
+  return hash;
+}
+
+/**
+ * @brief The Two Plus Two state table, mapped read-only from its file.
+ *
+ * The mapping is MAP_SHARED, so every process on the host walks the same
+ * page-cache copy, and 2 MB aligned with MADV_HUGEPAGE so the kernel may
+ * back it with huge pages. When HAND_RANKS_HUGETLBFS names a hugetlbfs
+ * mount, the table is copied there once (named by its checksum) and every
+ * process maps that copy instead, on explicit huge pages.
+ */
+class HandRanksTable {
+ public:
+  ~HandRanksTable();
+  HandRanksTable(const HandRanksTable&) = delete;
+  HandRanksTable& operator=(const HandRanksTable&) = delete;
+
+  // Maps and validates `path`. Throws std::runtime_error if it cannot be
+  // read, or is truncated or corrupt.
+  static std::shared_ptr<const HandRanksTable> open(const std::string& path);
+
+  // The table at `path`, opened on first use and kept for the life of the
+  // process; null, with a warning logged once, if open() failed
+  static std::shared_ptr<const HandRanksTable> shared(const std::string& path);
+
+  const int32_t* data() const { return data_; }
+  size_t size() const { return entries_; }
+  uint64_t checksum() const { return checksum_; }
+  bool huge_pages() const { return hugetlbfs_; }  // staged on hugetlbfs
+
+ private:
+  HandRanksTable(void* mapping, size_t mapped_bytes, size_t entries, uint64_t checksum,
+                 bool hugetlbfs);
+
+  void* mapping_;
+  size_t mapped_bytes_;
+  const int32_t* data_;
+  size_t entries_;
+  uint64_t checksum_;
+  bool hugetlbfs_;
+};
+
+}  // namespace poker_engine
+
+#endif  // EVALUATORS_HAND_RANKS_TABLE_H
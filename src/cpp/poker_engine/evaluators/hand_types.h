@@ -2,6 +2,10 @@
 #define EVALUATORS_HAND_TYPES_H
 
 #include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace poker_engine {
@@ -21,9 +25,53 @@ enum OptimizationFlags : uint8_t {
     MULTITHREADING = 1 << 0, // 1
     SIMD = 1 << 1,           // 2
     PERFECT_HASH = 1 << 2,   // 4
-    PREFETCHING = 1 << 3     // 8
+    PREFETCHING = 1 << 3,    // 8
+    EXHAUSTIVE = 1 << 4,     // 16: enumerate every deal instead of sampling
+    BOARD_MAJOR = 1 << 5,    // 32: deal once, score every hero hand on it
+    BOARD_CACHE = 1 << 6     // 64: look showdowns up in cached per-board ranks
 };
 
+// Case-insensitive name match for the API's enum strings
+inline bool option_name_equals(std::string_view name, std::string_view lower) {
+    if (name.size() != lower.size()) return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != lower[i]) return false;
+    }
+    return true;
+}
+
+// Algorithm name from a job request ("OMP_EVAL", "omp", ...). Unknown names
+// fall back to NAIVE.
+inline EvaluatorType parse_evaluator_type(std::string_view name) {
+    if (option_name_equals(name, "cactus_kev")) return EvaluatorType::CACTUS_KEV;
+    if (option_name_equals(name, "ph_evaluator") || option_name_equals(name, "perfect_hash")) {
+        return EvaluatorType::PH_EVALUATOR;
+    }
+    if (option_name_equals(name, "two_plus_two")) return EvaluatorType::TWO_PLUS_TWO;
+    if (option_name_equals(name, "omp_eval") || option_name_equals(name, "omp")) {
+        return EvaluatorType::OMP_EVAL;
+    }
+    return EvaluatorType::NAIVE;
+}
+
+// Optimization names from a job request as an OptimizationFlags bitmask.
+// Unknown names are ignored.
+inline uint8_t parse_optimization_flags(const std::vector<std::string>& names) {
+    uint8_t flags = NONE;
+    for (const auto& name : names) {
+        if (option_name_equals(name, "multithreading")) flags |= MULTITHREADING;
+        else if (option_name_equals(name, "simd")) flags |= SIMD;
+        else if (option_name_equals(name, "perfect_hash")) flags |= PERFECT_HASH;
+        else if (option_name_equals(name, "prefetching")) flags |= PREFETCHING;
+        else if (option_name_equals(name, "exhaustive")) flags |= EXHAUSTIVE;
+        else if (option_name_equals(name, "board_major")) flags |= BOARD_MAJOR;
+        else if (option_name_equals(name, "board_cache")) flags |= BOARD_CACHE;
+    }
+    return flags;
+}
+
 // Hand type values (matches Python get_hand_type)
 enum HandType : uint8_t {
     HIGH_CARD = 0,
@@ -68,7 +116,7 @@ inline HandType get_hand_type(int32_t hand_value) {
  * format: [Type: 4 bits][R1: 4][R2: 4][R3: 4][R4: 4][R5: 4]
  * This ensures perfect comparison including all kickers.
  */
-inline int32_t encode_score(HandType type, const std::vector<uint8_t>& sorted_ranks) {
+inline int32_t encode_score(HandType type, std::span<const uint8_t> sorted_ranks) {
     int32_t score = static_cast<int32_t>(type) * 1000000;
     
     // We add the ranks as a base-15 number (since Ace is 14)
@@ -80,6 +128,11 @@ inline int32_t encode_score(HandType type, const std::vector<uint8_t>& sorted_ra
     return score + relative;
 }
 
+// Brace-list form for fixed rank lists, e.g. encode_score(STRAIGHT, {9})
+inline int32_t encode_score(HandType type, std::initializer_list<uint8_t> sorted_ranks) {
+    return encode_score(type, std::span<const uint8_t>(sorted_ranks.begin(), sorted_ranks.size()));
+}
+
 }  // namespace poker_engine
 
 #endif // EVALUATORS_HAND_TYPES_H
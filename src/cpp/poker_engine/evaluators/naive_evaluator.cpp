@@ -1,8 +1,8 @@
 #include "naive_evaluator.h"
 #include "core/deck.h"
 #include <algorithm>
-#include <unordered_map>
-#include <unordered_set>
+#include <array>
+#include <functional>
 
 namespace poker_engine {
 
@@ -11,16 +11,25 @@ int32_t NaiveEvaluator::evaluate_hand(
     const std::vector<Card>& hole_cards,
     const std::vector<Card>& board_cards) const {
 
-    // Combine hole cards and board
-    std::vector<Card> all_cards = hole_cards;
-    all_cards.insert(all_cards.end(), board_cards.begin(), board_cards.end());
+    std::array<uint8_t, kMaxHandCards> ids;
+    size_t n = pack_card_ids(hole_cards, board_cards, ids);
+    return evaluate(CardIds(ids.data(), n));
+}
 
-    if (all_cards.size() < 5) {
+int32_t NaiveEvaluator::evaluate(CardIds cards) const {
+    size_t n = std::min(cards.size(), kMaxHandCards);
+    if (n < 5) {
         return 0;
     }
 
+    uint8_t all_ranks[kMaxHandCards];
+    uint8_t all_suits[kMaxHandCards];
+    for (size_t i = 0; i < n; ++i) {
+        all_ranks[i] = card_tables::kRank[cards[i]];
+        all_suits[i] = card_tables::kSuit[cards[i]];
+    }
+
     int32_t best_value = 0;
-    size_t n = all_cards.size();
 
     // Iterate all C(n,5) combinations using 5 nested loops
     // EXACT match of Python lines 12-25
@@ -29,15 +38,12 @@ int32_t NaiveEvaluator::evaluate_hand(
             for (size_t k = j + 1; k < n - 2; ++k) {
                 for (size_t l = k + 1; l < n - 1; ++l) {
                     for (size_t m = l + 1; m < n; ++m) {
-                        std::vector<Card> hand = {
-                            all_cards[i],
-                            all_cards[j],
-                            all_cards[k],
-                            all_cards[l],
-                            all_cards[m]
-                        };
-
-                        int32_t value = evaluate_five_cards(hand);
+                        const uint8_t ranks[5] = {all_ranks[i], all_ranks[j], all_ranks[k],
+                                                  all_ranks[l], all_ranks[m]};
+                        const uint8_t suits[5] = {all_suits[i], all_suits[j], all_suits[k],
+                                                  all_suits[l], all_suits[m]};
+
+                        int32_t value = evaluate_five_cards(ranks, suits);
                         best_value = std::max(best_value, value);
                     }
                 }
@@ -49,35 +55,36 @@ int32_t NaiveEvaluator::evaluate_hand(
 }
 
 // Matches: src/python/engine/strategies/naive/evaluator.py:94-142
-int32_t NaiveEvaluator::evaluate_five_cards(const std::vector<Card>& cards) const {
-    // Extract ranks and suits
-    std::vector<uint8_t> ranks;
-    std::vector<uint8_t> suits;
-    for (const auto& card : cards) {
-        ranks.push_back(card.rank);
-        suits.push_back(card.suit);
-    }
-
+int32_t NaiveEvaluator::evaluate_five_cards(const uint8_t* ranks, const uint8_t* suits) const {
     // Count rank occurrences
-    std::unordered_map<uint8_t, int> rank_counts;
-    for (uint8_t rank : ranks) {
-        rank_counts[rank]++;
+    uint8_t rank_counts[15] = {0};
+    for (int i = 0; i < 5; ++i) {
+        rank_counts[ranks[i]]++;
     }
 
     // Get sorted count pattern (e.g., [3, 2] for full house)
-    std::vector<int> counts;
-    for (const auto& pair : rank_counts) {
-        counts.push_back(pair.second);
+    uint8_t counts[5] = {0};
+    int num_counts = 0;
+    for (int r = 2; r <= 14; ++r) {
+        if (rank_counts[r] > 0) counts[num_counts++] = rank_counts[r];
     }
-    std::sort(counts.rbegin(), counts.rend());  // Descending
+    std::sort(counts, counts + num_counts, std::greater<uint8_t>());  // Descending
 
-    bool is_flush = (std::unordered_set<uint8_t>(suits.begin(), suits.end()).size() == 1);
+    // Ranks holding exactly `count` cards, highest first
+    auto ranks_with_count = [&](int count, uint8_t* out) {
+        int found = 0;
+        for (int r = 14; r >= 2; --r) {
+            if (rank_counts[r] == count) out[found++] = static_cast<uint8_t>(r);
+        }
+    };
+
+    bool is_flush = std::all_of(suits, suits + 5, [&](uint8_t s) { return s == suits[0]; });
     bool is_str = is_straight(ranks);
+    uint8_t max_rank = *std::max_element(ranks, ranks + 5);
 
     // Royal/Straight Flush
     if (is_str && is_flush) {
-        uint8_t max_rank = *std::max_element(ranks.begin(), ranks.end());
-        if (max_rank == 14 && *std::min_element(ranks.begin(), ranks.end()) == 10) {
+        if (max_rank == 14 && *std::min_element(ranks, ranks + 5) == 10) {
             return encode_score(HandType::ROYAL_FLUSH, {14, 13, 12, 11, 10});
         }
         return encode_score(HandType::STRAIGHT_FLUSH, {max_rank});
@@ -86,35 +93,31 @@ int32_t NaiveEvaluator::evaluate_five_cards(const std::vector<Card>& cards) cons
     // Four of a Kind
     if (counts[0] == 4) {
         uint8_t quad_rank = 0, kicker = 0;
-        for (const auto& pair : rank_counts) {
-            if (pair.second == 4) quad_rank = pair.first;
-            else kicker = pair.first;
-        }
+        ranks_with_count(4, &quad_rank);
+        ranks_with_count(1, &kicker);
         return encode_score(HandType::FOUR_OF_KIND, {quad_rank, kicker});
     }
 
     // Full House
-    if (counts == std::vector<int>{3, 2}) {
+    if (num_counts == 2 && counts[0] == 3) {
         uint8_t trips_rank = 0, pair_rank = 0;
-        for (const auto& pair : rank_counts) {
-            if (pair.second == 3) trips_rank = pair.first;
-            else pair_rank = pair.first;
-        }
+        ranks_with_count(3, &trips_rank);
+        ranks_with_count(2, &pair_rank);
         return encode_score(HandType::FULL_HOUSE, {trips_rank, pair_rank});
     }
 
     // Flush
     if (is_flush) {
-        std::vector<uint8_t> sorted = ranks;
-        std::sort(sorted.rbegin(), sorted.rend());
+        uint8_t sorted[5];
+        std::copy(ranks, ranks + 5, sorted);
+        std::sort(sorted, sorted + 5, std::greater<uint8_t>());
         return encode_score(HandType::FLUSH, sorted);
     }
 
     // Straight
     if (is_str) {
-        uint8_t max_rank = *std::max_element(ranks.begin(), ranks.end());
         // Handle Ace-low straight
-        if (max_rank == 14 && std::find(ranks.begin(), ranks.end(), 2) != ranks.end()) {
+        if (max_rank == 14 && rank_counts[2] > 0) {
             max_rank = 5;
         }
         return encode_score(HandType::STRAIGHT, {max_rank});
@@ -123,81 +126,55 @@ int32_t NaiveEvaluator::evaluate_five_cards(const std::vector<Card>& cards) cons
     // Three of a Kind
     if (counts[0] == 3) {
         uint8_t trips_rank = 0;
-        std::vector<uint8_t> kickers;
-        for (const auto& pair : rank_counts) {
-            if (pair.second == 3) trips_rank = pair.first;
-            else kickers.push_back(pair.first);
-        }
-        std::sort(kickers.rbegin(), kickers.rend());
+        uint8_t kickers[2] = {0, 0};
+        ranks_with_count(3, &trips_rank);
+        ranks_with_count(1, kickers);
         return encode_score(HandType::THREE_OF_KIND, {trips_rank, kickers[0], kickers[1]});
     }
 
     // Two Pair
-    if (counts == std::vector<int>{2, 2, 1}) {
-        std::vector<uint8_t> pairs;
+    if (num_counts == 3 && counts[0] == 2 && counts[1] == 2) {
+        uint8_t pairs[2] = {0, 0};
         uint8_t kicker = 0;
-        for (const auto& pair : rank_counts) {
-            if (pair.second == 2) pairs.push_back(pair.first);
-            else kicker = pair.first;
-        }
-        std::sort(pairs.rbegin(), pairs.rend());
+        ranks_with_count(2, pairs);
+        ranks_with_count(1, &kicker);
         return encode_score(HandType::TWO_PAIR, {pairs[0], pairs[1], kicker});
     }
 
     // One Pair
     if (counts[0] == 2) {
         uint8_t pair_rank = 0;
-        std::vector<uint8_t> kickers;
-        for (const auto& pair : rank_counts) {
-            if (pair.second == 2) pair_rank = pair.first;
-            else kickers.push_back(pair.first);
-        }
-        std::sort(kickers.rbegin(), kickers.rend());
+        uint8_t kickers[3] = {0, 0, 0};
+        ranks_with_count(2, &pair_rank);
+        ranks_with_count(1, kickers);
         return encode_score(HandType::ONE_PAIR, {pair_rank, kickers[0], kickers[1], kickers[2]});
     }
 
     // High Card
-    std::vector<uint8_t> sorted_ranks = ranks;
-    std::sort(sorted_ranks.rbegin(), sorted_ranks.rend());
+    uint8_t sorted_ranks[5];
+    std::copy(ranks, ranks + 5, sorted_ranks);
+    std::sort(sorted_ranks, sorted_ranks + 5, std::greater<uint8_t>());
     return encode_score(HandType::HIGH_CARD, sorted_ranks);
 }
 
 // Matches: src/python/engine/strategies/naive/evaluator.py:145-161
-bool NaiveEvaluator::is_straight(const std::vector<uint8_t>& ranks) const {
-    std::vector<uint8_t> sorted_ranks(ranks.begin(), ranks.end());
-    std::sort(sorted_ranks.begin(), sorted_ranks.end());
-    auto last = std::unique(sorted_ranks.begin(), sorted_ranks.end());
-    sorted_ranks.erase(last, sorted_ranks.end());
+bool NaiveEvaluator::is_straight(const uint8_t* ranks) const {
+    uint8_t sorted_ranks[5];
+    std::copy(ranks, ranks + 5, sorted_ranks);
+    std::sort(sorted_ranks, sorted_ranks + 5);
 
-    if (sorted_ranks.size() < 5) {
+    // Five distinct ranks are needed
+    if (std::unique(sorted_ranks, sorted_ranks + 5) != sorted_ranks + 5) {
         return false;
     }
 
     // Check regular straights
-    for (size_t i = 0; i <= sorted_ranks.size() - 5; ++i) {
-        if (sorted_ranks[i + 4] - sorted_ranks[i] == 4) {
-            return true;
-        }
+    if (sorted_ranks[4] - sorted_ranks[0] == 4) {
+        return true;
     }
 
     // Check Ace-low straight (A-2-3-4-5)
-    if (std::find(sorted_ranks.begin(), sorted_ranks.end(), 14) != sorted_ranks.end()) {
-        std::vector<uint8_t> low_ace_ranks;
-        for (uint8_t rank : sorted_ranks) {
-            low_ace_ranks.push_back(rank == 14 ? 1 : rank);
-        }
-        std::sort(low_ace_ranks.begin(), low_ace_ranks.end());
-        auto last_ace = std::unique(low_ace_ranks.begin(), low_ace_ranks.end());
-        low_ace_ranks.erase(last_ace, low_ace_ranks.end());
-
-        for (size_t i = 0; i <= low_ace_ranks.size() - 5; ++i) {
-            if (low_ace_ranks[i + 4] - low_ace_ranks[i] == 4) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return sorted_ranks[4] == 14 && sorted_ranks[3] == 5 && sorted_ranks[0] == 2;
 }
 
 // Matches: src/python/engine/strategies/naive/evaluator.py:30-83
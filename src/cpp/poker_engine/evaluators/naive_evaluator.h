@@ -1,11 +1,11 @@
 #ifndef EVALUATORS_NAIVE_EVALUATOR_H
 #define EVALUATORS_NAIVE_EVALUATOR_H
 
-#include <random>
 #include <string>
 #include <vector>
 
 #include "core/card.h"
+#include "evaluator_interface.h"
 #include "hand_types.h"
 
 namespace poker_engine {
@@ -27,6 +27,9 @@ class NaiveEvaluator {
   int32_t evaluate_hand(const std::vector<Card>& hole_cards,
                         const std::vector<Card>& board_cards) const;
 
+  // Evaluate 5-7 card ids without allocating (see evaluator_interface.h)
+  int32_t evaluate(CardIds cards) const;
+
   // Simulate one hand against N opponents
   // Matches: src/python/engine/strategies/naive/evaluator.py:30-83
   SimulationResult simulate_hand(const std::vector<Card>& hole_cards,
@@ -40,14 +43,11 @@ class NaiveEvaluator {
  private:
   // Evaluate specific 5-card combination
   // Matches: src/python/engine/strategies/naive/evaluator.py:94-142
-  int32_t evaluate_five_cards(const std::vector<Card>& cards) const;
+  int32_t evaluate_five_cards(const uint8_t* ranks, const uint8_t* suits) const;
 
-  // Check if ranks form a straight
+  // Check if five ranks form a straight
   // Matches: src/python/engine/strategies/naive/evaluator.py:145-161
-  bool is_straight(const std::vector<uint8_t>& ranks) const;
-
-  // Thread-local RNG for deck shuffling
-  mutable std::mt19937 rng_{std::random_device{}()};
+  bool is_straight(const uint8_t* ranks) const;
 };
 
 }  // namespace poker_engine
@@ -0,0 +1,69 @@
+#include "omp_batch_kernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace poker_engine {
+
+#if defined(__AVX2__)
+namespace {
+
+struct Avx2Ops {
+    using Vec = __m256i;
+    using Mask = __m256i;  // all-ones / all-zeros lanes
+    static constexpr int kLanes = 8;
+
+    static Vec load(const uint32_t* p) {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void store(int32_t* p, Vec v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static Vec set1(int32_t x) { return _mm256_set1_epi32(x); }
+    static Vec zero() { return _mm256_setzero_si256(); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+    static Vec and_(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    static Vec or_(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static Vec andnot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); }
+    template <int N> static Vec slli(Vec v) { return _mm256_slli_epi32(v, N); }
+    template <int N> static Vec srli(Vec v) { return _mm256_srli_epi32(v, N); }
+
+    // 1 << n per lane; out-of-range (negative) counts give 0
+    static Vec shl_one(Vec n) { return _mm256_sllv_epi32(_mm256_set1_epi32(1), n); }
+
+    // Rank masks are < 2^13, so the float conversion is exact and the
+    // unbiased exponent is the bit index. Zero lanes yield -127.
+    static Vec high_bit_index(Vec v) {
+        Vec bits = _mm256_castps_si256(_mm256_cvtepi32_ps(v));
+        return _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    }
+
+    static Mask eq(Vec a, Vec b) { return _mm256_cmpeq_epi32(a, b); }
+    static Mask gt(Vec a, Vec b) { return _mm256_cmpgt_epi32(a, b); }
+    static Mask nonzero(Vec v) {
+        return _mm256_xor_si256(_mm256_cmpeq_epi32(v, zero()), _mm256_set1_epi32(-1));
+    }
+    static Mask mask_and(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+    static Vec and_mask(Mask m, Vec v) { return _mm256_and_si256(m, v); }
+    static Vec count(Vec counts, Mask m) { return _mm256_sub_epi32(counts, m); }
+    static Vec select(Mask m, Vec if_false, Vec if_true) {
+        return _mm256_blendv_epi8(if_false, if_true, m);
+    }
+};
+
+}  // namespace
+#endif
+
+void evaluate_batch_avx2(const HandBatch& batch, int lanes, int32_t* results) {
+#if defined(__AVX2__)
+    for (int lane = 0; lane < lanes; lane += Avx2Ops::kLanes) {
+        BatchKernel<Avx2Ops>::evaluate(batch, lane, results + lane);
+    }
+#else
+    evaluate_batch_scalar(batch, lanes, results);
+#endif
+}
+
+}  // namespace poker_engine
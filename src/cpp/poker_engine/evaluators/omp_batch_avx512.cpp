@@ -0,0 +1,63 @@
+#include "omp_batch_kernels.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace poker_engine {
+
+#if defined(__AVX512F__)
+namespace {
+
+struct Avx512Ops {
+    using Vec = __m512i;
+    using Mask = __mmask16;  // one bit per lane in a k-register
+    static constexpr int kLanes = 16;
+
+    static Vec load(const uint32_t* p) { return _mm512_load_si512(p); }
+    static void store(int32_t* p, Vec v) { _mm512_storeu_si512(p, v); }
+    static Vec set1(int32_t x) { return _mm512_set1_epi32(x); }
+    static Vec zero() { return _mm512_setzero_si512(); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_epi32(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_epi32(a, b); }
+    static Vec and_(Vec a, Vec b) { return _mm512_and_si512(a, b); }
+    static Vec or_(Vec a, Vec b) { return _mm512_or_si512(a, b); }
+    static Vec andnot(Vec a, Vec b) { return _mm512_andnot_si512(a, b); }
+    template <int N> static Vec slli(Vec v) { return _mm512_slli_epi32(v, N); }
+    template <int N> static Vec srli(Vec v) { return _mm512_srli_epi32(v, N); }
+
+    // 1 << n per lane; out-of-range (negative) counts give 0
+    static Vec shl_one(Vec n) { return _mm512_sllv_epi32(_mm512_set1_epi32(1), n); }
+
+    static Vec high_bit_index(Vec v) {
+        Vec bits = _mm512_castps_si512(_mm512_cvtepi32_ps(v));
+        return _mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(127));
+    }
+
+    static Mask eq(Vec a, Vec b) { return _mm512_cmpeq_epi32_mask(a, b); }
+    static Mask gt(Vec a, Vec b) { return _mm512_cmpgt_epi32_mask(a, b); }
+    static Mask nonzero(Vec v) { return _mm512_test_epi32_mask(v, v); }
+    static Mask mask_and(Mask a, Mask b) { return _kand_mask16(a, b); }
+    static Vec and_mask(Mask m, Vec v) { return _mm512_maskz_mov_epi32(m, v); }
+    static Vec count(Vec counts, Mask m) {
+        return _mm512_mask_add_epi32(counts, m, counts, _mm512_set1_epi32(1));
+    }
+    static Vec select(Mask m, Vec if_false, Vec if_true) {
+        return _mm512_mask_blend_epi32(m, if_false, if_true);
+    }
+};
+
+}  // namespace
+#endif
+
+void evaluate_batch_avx512(const HandBatch& batch, int lanes, int32_t* results) {
+#if defined(__AVX512F__)
+    for (int lane = 0; lane < lanes; lane += Avx512Ops::kLanes) {
+        BatchKernel<Avx512Ops>::evaluate(batch, lane, results + lane);
+    }
+#else
+    evaluate_batch_avx2(batch, lanes, results);
+#endif
+}
+
+}  // namespace poker_engine
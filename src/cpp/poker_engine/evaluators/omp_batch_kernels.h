@@ -0,0 +1,169 @@
+#ifndef EVALUATORS_OMP_BATCH_KERNELS_H
+#define EVALUATORS_OMP_BATCH_KERNELS_H
+
+#include <cstdint>
+
+#include "engine/simd_helper.h"
+#include "hand_types.h"
+
+namespace poker_engine {
+
+// Batch kernels for OMPEval, one per instruction set. Each lives in its own
+// translation unit compiled with the matching -m flags (see CMakeLists.txt),
+// and OMPEval picks one at construction from the cpuid-detected SimdLevel.
+// A kernel evaluates `lanes` hands (a multiple of its native width) and
+// writes scores in the encode_score() format.
+void evaluate_batch_scalar(const HandBatch& batch, int lanes, int32_t* results);
+void evaluate_batch_sse4(const HandBatch& batch, int lanes, int32_t* results);
+void evaluate_batch_avx2(const HandBatch& batch, int lanes, int32_t* results);
+void evaluate_batch_avx512(const HandBatch& batch, int lanes, int32_t* results);
+
+// Everything below is included by the per-ISA translation units only. It is
+// kept in an unnamed namespace on purpose: inline functions compiled with
+// -mavx512f in one object must never be merged with the copy the scalar
+// object uses, or an older host would execute AVX-512 instructions.
+namespace {
+
+// encode_score(ROYAL_FLUSH, {14, 13, 12, 11, 10}) folded to a constant
+constexpr int32_t kRoyalFlushScore =
+    ROYAL_FLUSH_MIN + (((14 * 15 + 13) * 15 + 12) * 15 + 11) * 15 + 10;
+
+/**
+ * @brief Branch-free 7-card evaluation written against a vector ISA.
+ *
+ * V supplies the lane type and the handful of integer operations the kernel
+ * needs (and/or/add/shift, a variable 1 << n, a highest-set-bit index,
+ * compares producing a Mask, and a select). Every category's score is
+ * computed for every lane and the winner is blended in from the weakest
+ * category up, so there are no data-dependent branches.
+ */
+template <typename V>
+struct BatchKernel {
+  using Vec = typename V::Vec;
+  using Mask = typename V::Mask;
+
+  // Pops the highest rank (2-14) out of a rank mask
+  static Vec pop_high(Vec& mask) {
+    Vec index = V::high_bit_index(mask);
+    mask = V::andnot(V::shl_one(index), mask);
+    return V::add(index, V::set1(2));
+  }
+
+  static Vec clear_rank(Vec mask, Vec rank) {
+    return V::andnot(V::shl_one(V::sub(rank, V::set1(2))), mask);
+  }
+
+  static Vec times15(Vec v) { return V::sub(V::template slli<4>(v), v); }
+
+  // Rank of the top card of the best straight in a rank mask, or 0. The ace
+  // is mirrored below the deuce so the wheel falls out of the same run test.
+  static Vec straight_high(Vec mask) {
+    Vec m = V::or_(V::template slli<1>(mask),
+                   V::and_(V::template srli<12>(mask), V::set1(1)));
+    Vec run = V::and_(V::and_(m, V::template srli<1>(m)),
+                      V::and_(V::template srli<2>(m), V::template srli<3>(m)));
+    run = V::and_(run, V::template srli<4>(m));
+    Vec high = V::add(V::high_bit_index(run), V::set1(5));
+    return V::select(V::nonzero(run), V::zero(), high);
+  }
+
+  static Vec top_five(Vec mask) {
+    Vec relative = V::zero();
+    for (int k = 0; k < 5; ++k) relative = V::add(times15(relative), pop_high(mask));
+    return relative;
+  }
+
+  static void evaluate(const HandBatch& batch, int offset, int32_t* results) {
+    const Vec zero = V::zero();
+
+    // c1..c4: ranks seen at least 1..4 times
+    Vec c1 = zero, c2 = zero, c3 = zero, c4 = zero;
+    Vec suit_masks[4] = {zero, zero, zero, zero};
+    Vec suit_counts[4] = {zero, zero, zero, zero};
+
+    for (int i = 0; i < 7; ++i) {
+      Vec rank = V::load(&batch.ranks[i][offset]);
+      Vec suit = V::load(&batch.suits[i][offset]);
+      Vec bit = V::shl_one(V::sub(rank, V::set1(2)));
+
+      c4 = V::or_(c4, V::and_(c3, bit));
+      c3 = V::or_(c3, V::and_(c2, bit));
+      c2 = V::or_(c2, V::and_(c1, bit));
+      c1 = V::or_(c1, bit);
+
+      for (int s = 0; s < 4; ++s) {
+        Mask is_suit = V::eq(suit, V::set1(s));
+        suit_masks[s] = V::or_(suit_masks[s], V::and_mask(is_suit, bit));
+        suit_counts[s] = V::count(suit_counts[s], is_suit);
+      }
+    }
+
+    // At most one suit can hold five of seven cards
+    Vec flush = zero;
+    for (int s = 0; s < 4; ++s) {
+      flush = V::or_(flush, V::and_mask(V::gt(suit_counts[s], V::set1(4)), suit_masks[s]));
+    }
+
+    // High card
+    Vec score = top_five(c1);
+
+    // One pair / two pair
+    Vec pairs = c2;
+    Vec p1 = pop_high(pairs);
+    Vec kickers = clear_rank(c1, p1);
+    Vec pair_kickers = kickers;
+    Vec relative = p1;
+    for (int k = 0; k < 3; ++k) relative = V::add(times15(relative), pop_high(pair_kickers));
+    score = V::select(V::nonzero(c2), score, V::add(relative, V::set1(ONE_PAIR_MIN)));
+
+    Mask has_two_pair = V::nonzero(pairs);
+    Vec p2 = pop_high(pairs);
+    Vec two_pair_kicker = clear_rank(kickers, p2);
+    relative = V::add(times15(V::add(times15(p1), p2)), pop_high(two_pair_kicker));
+    score = V::select(has_two_pair, score, V::add(relative, V::set1(TWO_PAIR_MIN)));
+
+    // Trips
+    Vec trips_rest = c3;
+    Vec trips = pop_high(trips_rest);
+    Mask has_trips = V::nonzero(c3);
+    Vec trip_kickers = clear_rank(c1, trips);
+    Vec k1 = pop_high(trip_kickers);
+    relative = V::add(times15(V::add(times15(trips), k1)), pop_high(trip_kickers));
+    score = V::select(has_trips, score, V::add(relative, V::set1(THREE_KIND_MIN)));
+
+    // Straight
+    Vec straight = straight_high(c1);
+    score = V::select(V::nonzero(straight), score, V::add(straight, V::set1(STRAIGHT_MIN)));
+
+    // Flush (top five suited ranks)
+    score = V::select(V::nonzero(flush), score, V::add(top_five(flush), V::set1(FLUSH_MIN)));
+
+    // Full house: top trips plus the best other rank seen twice or more
+    Vec fh_pairs = clear_rank(c2, trips);
+    Mask has_full_house = V::mask_and(has_trips, V::nonzero(fh_pairs));
+    relative = V::add(times15(trips), pop_high(fh_pairs));
+    score = V::select(has_full_house, score, V::add(relative, V::set1(FULL_HOUSE_MIN)));
+
+    // Quads
+    Vec quad_rest = c4;
+    Vec quad = pop_high(quad_rest);
+    Vec quad_kickers = clear_rank(c1, quad);
+    relative = V::add(times15(quad), pop_high(quad_kickers));
+    score = V::select(V::nonzero(c4), score, V::add(relative, V::set1(FOUR_KIND_MIN)));
+
+    // Straight flush / royal flush
+    Vec sf = straight_high(flush);
+    Vec sf_score = V::select(V::eq(sf, V::set1(14)),
+                             V::add(sf, V::set1(STRAIGHT_FLUSH_MIN)),
+                             V::set1(kRoyalFlushScore));
+    score = V::select(V::nonzero(sf), score, sf_score);
+
+    V::store(results, score);
+  }
+};
+
+}  // namespace
+
+}  // namespace poker_engine
+
+#endif  // EVALUATORS_OMP_BATCH_KERNELS_H
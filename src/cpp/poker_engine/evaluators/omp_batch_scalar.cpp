@@ -0,0 +1,113 @@
+#include "omp_batch_kernels.h"
+
+#include <bit>
+
+namespace poker_engine {
+
+namespace {
+
+// Highest straight in a 13-bit rank mask (bit 0 = deuce), as the rank of its
+// top card, or 0 if there is none. The ace is mirrored below the deuce so the
+// wheel falls out of the same run test.
+inline uint32_t straight_high(uint32_t mask) {
+    uint32_t m = (mask << 1) | ((mask >> 12) & 1);
+    uint32_t run = m & (m >> 1) & (m >> 2) & (m >> 3) & (m >> 4);
+    if (run == 0) return 0;
+    return std::bit_width(run) + 4;
+}
+
+// Pops the highest rank (2-14) out of a rank mask
+inline uint32_t pop_high(uint32_t& mask) {
+    uint32_t bit = std::bit_width(mask) - 1;
+    mask &= ~(1u << bit);
+    return bit + 2;
+}
+
+// Scalar version of the batch kernel. Works on one lane of a HandBatch
+// without materializing Card vectors.
+int32_t evaluate_lane(const uint32_t* ranks, const uint32_t* suits) {
+    // c1..c4: ranks seen at least 1..4 times
+    uint32_t c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+    uint32_t suit_masks[4] = {0};
+    uint32_t suit_counts[4] = {0};
+
+    for (int i = 0; i < 7; ++i) {
+        uint32_t bit = 1u << (ranks[i] - 2);
+        c4 |= c3 & bit;
+        c3 |= c2 & bit;
+        c2 |= c1 & bit;
+        c1 |= bit;
+        suit_masks[suits[i]] |= bit;
+        suit_counts[suits[i]]++;
+    }
+
+    for (int s = 0; s < 4; ++s) {
+        if (suit_counts[s] < 5) continue;
+        uint32_t flush = suit_masks[s];
+        uint32_t sf = straight_high(flush);
+        if (sf == 14) return kRoyalFlushScore;
+        if (sf) return STRAIGHT_FLUSH_MIN + sf;
+        int32_t relative = 0;
+        for (int k = 0; k < 5; ++k) relative = relative * 15 + pop_high(flush);
+        return FLUSH_MIN + relative;
+    }
+
+    if (c4) {
+        uint32_t rest = c4;
+        uint32_t quad = pop_high(rest);
+        uint32_t kickers = c1 & ~(1u << (quad - 2));
+        return FOUR_KIND_MIN + quad * 15 + pop_high(kickers);
+    }
+
+    if (c3) {
+        uint32_t rest = c3;
+        uint32_t trips = pop_high(rest);
+        uint32_t pairs = c2 & ~(1u << (trips - 2));
+        if (pairs) return FULL_HOUSE_MIN + trips * 15 + pop_high(pairs);
+    }
+
+    if (uint32_t st = straight_high(c1)) return STRAIGHT_MIN + st;
+
+    if (c3) {
+        uint32_t rest = c3;
+        uint32_t trips = pop_high(rest);
+        uint32_t kickers = c1 & ~(1u << (trips - 2));
+        uint32_t k1 = pop_high(kickers);
+        return THREE_KIND_MIN + (trips * 15 + k1) * 15 + pop_high(kickers);
+    }
+
+    if (c2) {
+        uint32_t pairs = c2;
+        uint32_t p1 = pop_high(pairs);
+        uint32_t kickers = c1 & ~(1u << (p1 - 2));
+        if (pairs) {
+            uint32_t p2 = pop_high(pairs);
+            kickers &= ~(1u << (p2 - 2));
+            return TWO_PAIR_MIN + (p1 * 15 + p2) * 15 + pop_high(kickers);
+        }
+        int32_t relative = p1;
+        for (int k = 0; k < 3; ++k) relative = relative * 15 + pop_high(kickers);
+        return ONE_PAIR_MIN + relative;
+    }
+
+    uint32_t high = c1;
+    int32_t relative = 0;
+    for (int k = 0; k < 5; ++k) relative = relative * 15 + pop_high(high);
+    return relative;
+}
+
+}  // namespace
+
+void evaluate_batch_scalar(const HandBatch& batch, int lanes, int32_t* results) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        uint32_t ranks[7];
+        uint32_t suits[7];
+        for (int c = 0; c < 7; ++c) {
+            ranks[c] = batch.ranks[c][lane];
+            suits[c] = batch.suits[c][lane];
+        }
+        results[lane] = evaluate_lane(ranks, suits);
+    }
+}
+
+}  // namespace poker_engine
@@ -0,0 +1,72 @@
+#include "omp_batch_kernels.h"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace poker_engine {
+
+#if defined(__SSE4_1__)
+namespace {
+
+struct Sse4Ops {
+    using Vec = __m128i;
+    using Mask = __m128i;  // all-ones / all-zeros lanes
+    static constexpr int kLanes = 4;
+
+    static Vec load(const uint32_t* p) {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static void store(int32_t* p, Vec v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+    static Vec set1(int32_t x) { return _mm_set1_epi32(x); }
+    static Vec zero() { return _mm_setzero_si128(); }
+    static Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+    static Vec and_(Vec a, Vec b) { return _mm_and_si128(a, b); }
+    static Vec or_(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static Vec andnot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+    template <int N> static Vec slli(Vec v) { return _mm_slli_epi32(v, N); }
+    template <int N> static Vec srli(Vec v) { return _mm_srli_epi32(v, N); }
+
+    // SSE has no per-lane variable shift, so 1 << n is built as the float
+    // 2^n and truncated back. Only n in [0, 12] and n = -127 (the index of
+    // an empty mask, which maps to 0.0f) ever reach here.
+    static Vec shl_one(Vec n) {
+        Vec bits = _mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23);
+        return _mm_cvttps_epi32(_mm_castsi128_ps(bits));
+    }
+
+    static Vec high_bit_index(Vec v) {
+        Vec bits = _mm_castps_si128(_mm_cvtepi32_ps(v));
+        return _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    }
+
+    static Mask eq(Vec a, Vec b) { return _mm_cmpeq_epi32(a, b); }
+    static Mask gt(Vec a, Vec b) { return _mm_cmpgt_epi32(a, b); }
+    static Mask nonzero(Vec v) {
+        return _mm_xor_si128(_mm_cmpeq_epi32(v, zero()), _mm_set1_epi32(-1));
+    }
+    static Mask mask_and(Mask a, Mask b) { return _mm_and_si128(a, b); }
+    static Vec and_mask(Mask m, Vec v) { return _mm_and_si128(m, v); }
+    static Vec count(Vec counts, Mask m) { return _mm_sub_epi32(counts, m); }
+    static Vec select(Mask m, Vec if_false, Vec if_true) {
+        return _mm_blendv_epi8(if_false, if_true, m);
+    }
+};
+
+}  // namespace
+#endif
+
+void evaluate_batch_sse4(const HandBatch& batch, int lanes, int32_t* results) {
+#if defined(__SSE4_1__)
+    for (int lane = 0; lane < lanes; lane += Sse4Ops::kLanes) {
+        BatchKernel<Sse4Ops>::evaluate(batch, lane, results + lane);
+    }
+#else
+    evaluate_batch_scalar(batch, lanes, results);
+#endif
+}
+
+}  // namespace poker_engine
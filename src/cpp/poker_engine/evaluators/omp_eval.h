@@ -2,6 +2,7 @@
 #define EVALUATORS_OMP_EVAL_H
 
 #include "core/card.h"
+#include "evaluator_interface.h"
 #include "../engine/simd_helper.h"
 #include <vector>
 
@@ -9,14 +10,43 @@ namespace poker_engine {
 
 class OMPEval {
  public:
+  // Uses the widest instruction set the CPU supports
   OMPEval();
 
+  // Pins the batch kernel to a level (clamped to what the CPU supports)
+  explicit OMPEval(SimdLevel level);
+
   // Evaluate best 5-card hand from 7 cards (pure bit math)
   int32_t evaluate_hand(const std::vector<Card>& hole_cards,
                         const std::vector<Card>& board_cards) const;
 
-  // Batch evaluation using SIMD Framework
+  // Evaluate 5-7 card ids without allocating (see evaluator_interface.h)
+  int32_t evaluate(CardIds cards) const;
+
+  // Partial state: the cards' rank and suit tallies (see
+  // IncrementalEvaluator in evaluator_interface.h)
+  using State = RankSuitCounts;
+  State add(State state, uint8_t id) const {
+    state.add(id);
+    return state;
+  }
+  int32_t evaluate(const State& state) const;
+
+  // Batch evaluation using SIMD Framework. Evaluates the first batch_size()
+  // lanes of the batch and writes batch_size() results.
   void evaluate_batch(const HandBatch& batch, int32_t* results) const;
+
+  // Lanes filled per evaluate_batch call (16 with AVX-512, otherwise 8)
+  int batch_size() const { return batch_size_; }
+
+  SimdLevel simd_level() const { return level_; }
+
+ private:
+  using BatchKernelFn = void (*)(const HandBatch&, int, int32_t*);
+
+  SimdLevel level_;
+  int batch_size_;
+  BatchKernelFn batch_kernel_;
 };
 
 }  // namespace poker_engine
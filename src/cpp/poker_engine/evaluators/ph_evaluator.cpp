@@ -1,6 +1,5 @@
 #include "ph_evaluator.h"
 #include "hand_types.h"
-#include <algorithm>
 #include <array>
 
 namespace poker_engine {
@@ -10,28 +9,32 @@ PHEvaluator::PHEvaluator() {
 }
 
 int32_t PHEvaluator::evaluate_hand(const std::vector<Card>& hole_cards,
-                                  const std::vector<Card>& board_cards) const {
-    uint32_t ranks_mask = 0;
-    uint8_t rank_counts[15] = {0};
-    uint8_t suit_counts[4] = {0};
-    uint32_t suit_masks[4] = {0};
-    std::vector<uint8_t> all_ranks;
+                                   const std::vector<Card>& board_cards) const {
+    std::array<uint8_t, kMaxHandCards> ids;
+    size_t n = pack_card_ids(hole_cards, board_cards, ids);
+    return evaluate(CardIds(ids.data(), n));
+}
 
-    auto process_card = [&](const Card& c) {
-        ranks_mask |= (1 << (c.rank - 2));
-        rank_counts[c.rank]++;
-        suit_counts[c.suit]++;
-        suit_masks[c.suit] |= (1 << (c.rank - 2));
-        all_ranks.push_back(c.rank);
-    };
+int32_t PHEvaluator::evaluate(CardIds cards) const {
+    State state;
+    for (uint8_t id : cards) state.add(id);
+    return evaluate(state);
+}
 
-    for (const auto& c : hole_cards) process_card(c);
-    for (const auto& c : board_cards) process_card(c);
+int32_t PHEvaluator::evaluate(const State& state) const {
+    const uint32_t ranks_mask = state.ranks_mask;
+
+    // Highest ranks present other than `skip1`/`skip2`, written to `out`
+    auto kickers = [&](int skip1, int skip2, uint8_t* out, int n) {
+        for (int k = 14, found = 0; k >= 2 && found < n; k--) {
+            if (((ranks_mask >> (k - 2)) & 1) && k != skip1 && k != skip2) out[found++] = static_cast<uint8_t>(k);
+        }
+    };
 
     // 1. Flush Check
     for (int s = 0; s < 4; s++) {
-        if (suit_counts[s] >= 5) {
-            uint32_t mask = suit_masks[s];
+        if (state.suit_count(s) >= 5) {
+            uint32_t mask = state.suit_mask(s);
             // SF check
             for (int r = 12; r >= 4; r--) {
                 if ((mask & (0x1F << (r - 4))) == (0x1F << (r - 4))) {
@@ -41,31 +44,30 @@ int32_t PHEvaluator::evaluate_hand(const std::vector<Card>& hole_cards,
             }
             if ((mask & 0x100F) == 0x100F) return encode_score(HandType::STRAIGHT_FLUSH, {5});
             
-            std::vector<uint8_t> flush_ranks;
-            for(int r=14; r>=2; r--) if((mask >> (r-2)) & 1) flush_ranks.push_back(r);
+            uint8_t flush_ranks[5];
+            int n = 0;
+            for(int r=14; r>=2 && n<5; r--) if((mask >> (r-2)) & 1) flush_ranks[n++] = r;
             return encode_score(HandType::FLUSH, flush_ranks);
         }
     }
 
     // 2. Quads
-    for (int r = 14; r >= 2; r--) {
-        if (rank_counts[r] == 4) {
-            uint8_t kicker = 0;
-            for(int k=14; k>=2; k--) if(rank_counts[k] > 0 && k != r) { kicker = k; break; }
-            return encode_score(HandType::FOUR_OF_KIND, {static_cast<uint8_t>(r), kicker});
-        }
+    if (const uint64_t quads = state.ranks_with_count(4)) {
+        const int r = State::top_rank(quads);
+        uint8_t kicker = 0;
+        kickers(r, 0, &kicker, 1);
+        return encode_score(HandType::FOUR_OF_KIND, {static_cast<uint8_t>(r), kicker});
     }
 
-    // 3. Full House
+    // 3. Full House (a second set of trips counts as the pair)
+    uint64_t threes = state.ranks_with_count(3);
+    const uint64_t twos = state.ranks_with_count(2);
     int trips = 0, pair = 0;
-    for (int r = 14; r >= 2; r--) {
-        if (rank_counts[r] == 3) {
-            if (trips == 0) trips = r;
-            else if (pair == 0) pair = r;
-        } else if (rank_counts[r] == 2) {
-            if (pair == 0) pair = r;
-        }
+    if (threes) {
+        trips = State::top_rank(threes);
+        threes &= ~(1ULL << (4 * trips));
     }
+    if (threes | twos) pair = State::top_rank(threes | twos);
     if (trips && pair) return encode_score(HandType::FULL_HOUSE, {static_cast<uint8_t>(trips), static_cast<uint8_t>(pair)});
 
     // 4. Straight
@@ -76,40 +78,34 @@ int32_t PHEvaluator::evaluate_hand(const std::vector<Card>& hole_cards,
 
     // 5. Trips
     if (trips) {
-        std::vector<uint8_t> kickers;
-        for(int k=14; k>=2; k--) if(rank_counts[k] > 0 && k != trips) kickers.push_back(k);
-        return encode_score(HandType::THREE_OF_KIND, {static_cast<uint8_t>(trips), kickers[0], kickers[1]});
+        uint8_t k[2] = {0, 0};
+        kickers(trips, 0, k, 2);
+        return encode_score(HandType::THREE_OF_KIND, {static_cast<uint8_t>(trips), k[0], k[1]});
     }
 
     // 6. Two Pair
     int p1 = 0, p2 = 0;
-    for (int r = 14; r >= 2; r--) {
-        if (rank_counts[r] == 2) {
-            if (p1 == 0) p1 = r;
-            else if (p2 == 0) p2 = r;
-        }
+    if (twos) {
+        p1 = State::top_rank(twos);
+        const uint64_t rest = twos & ~(1ULL << (4 * p1));
+        if (rest) p2 = State::top_rank(rest);
     }
     if (p1 && p2) {
         uint8_t kicker = 0;
-        for(int k=14; k>=2; k--) if(rank_counts[k] > 0 && k != p1 && k != p2) { kicker = k; break; }
+        kickers(p1, p2, &kicker, 1);
         return encode_score(HandType::TWO_PAIR, {static_cast<uint8_t>(p1), static_cast<uint8_t>(p2), kicker});
     }
 
     // 7. One Pair
     if (p1) {
-        std::vector<uint8_t> kickers;
-        for(int k=14; k>=2; k--) if(rank_counts[k] > 0 && k != p1) kickers.push_back(k);
-        return encode_score(HandType::ONE_PAIR, {static_cast<uint8_t>(p1), kickers[0], kickers[1], kickers[2]});
+        uint8_t k[3] = {0, 0, 0};
+        kickers(p1, 0, k, 3);
+        return encode_score(HandType::ONE_PAIR, {static_cast<uint8_t>(p1), k[0], k[1], k[2]});
     }
 
-    // 8. High Card
-    std::vector<uint8_t> sorted = all_ranks;
-    std::sort(sorted.rbegin(), sorted.rend());
-    return encode_score(HandType::HIGH_CARD, sorted);
-}
-
-void PHEvaluator::prefetch(const std::vector<Card>& cards) const {
-    // Multiplier: Prefetching data into cache
-    // __builtin_prefetch(ptr);
+    // 8. High Card (no pairs, so the distinct ranks are the cards)
+    uint8_t high[5] = {0, 0, 0, 0, 0};
+    kickers(0, 0, high, 5);
+    return encode_score(HandType::HIGH_CARD, high);
 }
 }  // namespace poker_engine
@@ -2,6 +2,7 @@
 #define EVALUATORS_PH_EVALUATOR_H
 
 #include "core/card.h"
+#include "evaluator_interface.h"
 #include <vector>
 
 namespace poker_engine {
@@ -14,8 +15,17 @@ class PHEvaluator {
   int32_t evaluate_hand(const std::vector<Card>& hole_cards,
                         const std::vector<Card>& board_cards) const;
 
- private:
-  void prefetch(const std::vector<Card>& cards) const;
+  // Evaluate 5-7 card ids without allocating (see evaluator_interface.h)
+  int32_t evaluate(CardIds cards) const;
+
+  // Partial state: the cards' rank and suit tallies (see
+  // IncrementalEvaluator in evaluator_interface.h)
+  using State = RankSuitCounts;
+  State add(State state, uint8_t id) const {
+    state.add(id);
+    return state;
+  }
+  int32_t evaluate(const State& state) const;
 };
 
 }  // namespace poker_engine
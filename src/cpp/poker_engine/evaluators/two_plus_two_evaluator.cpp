@@ -1,82 +1,88 @@
 #include "two_plus_two_evaluator.h"
 #include "hand_types.h"
 #include <iostream>
-#include <fstream>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdio>
 
 namespace poker_engine {
 
-TwoPlusTwoEvaluator::TwoPlusTwoEvaluator() : table_loaded_(false) {
-    load_table("HandRanks.dat");
+TwoPlusTwoEvaluator::TwoPlusTwoEvaluator()
+    : table_(HandRanksTable::shared("HandRanks.dat")), table_loaded_(table_ != nullptr) {
+    if (table_loaded_) {
+        lookup_table_ = table_->data();
+    } else {
+        std::cerr << "Warning: no usable HandRanks.dat. Using fallback evaluator." << std::endl;
+    }
 }
 
-void TwoPlusTwoEvaluator::load_table(const char* filename) {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        std::cerr << "Warning: Could not open " << filename << ". Using fallback evaluator." << std::endl;
-        return;
+int32_t TwoPlusTwoEvaluator::evaluate_hand(const std::vector<Card>& hole_cards,
+                                           const std::vector<Card>& board_cards) const {
+    if (!table_loaded_) {
+        std::array<uint8_t, kMaxHandCards> ids;
+        size_t n = pack_card_ids(hole_cards, board_cards, ids);
+        return evaluate_fallback(CardIds(ids.data(), n));
     }
 
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    lookup_table_.resize(size / sizeof(int32_t));
-    if (file.read(reinterpret_cast<char*>(lookup_table_.data()), size)) {
-        table_loaded_ = true;
-        std::cout << "Successfully loaded Two Plus Two lookup table (" << size / (1024*1024) << " MB)." << std::endl;
+    // Walk straight from the Cards: the walk is a chain of cache misses, and
+    // packing ids first costs enough instructions per hand that the CPU
+    // overlaps fewer independent walks.
+    int p = 53;
+    for (const auto& c : hole_cards) p = lookup_table_[p + card_id(c) + 1];
+    for (const auto& c : board_cards) p = lookup_table_[p + card_id(c) + 1];
+    if (hole_cards.size() + board_cards.size() < 7) {
+        p = lookup_table_[p];
     }
+    return p;
 }
 
-int32_t TwoPlusTwoEvaluator::evaluate_hand(const std::vector<Card>& hole_cards,
-                                           const std::vector<Card>& board_cards) const {
+int32_t TwoPlusTwoEvaluator::evaluate(CardIds cards) const {
     if (!table_loaded_) {
-        return evaluate_fallback(hole_cards, board_cards);
+        return evaluate_fallback(cards);
     }
 
     // TwoPlusTwo Traversal Logic
     int p = 53; // Start index
 
-    auto process_card = [&](const Card& c) {
-        int card_val = (c.rank - 2) * 4 + c.suit + 1;
+    for (uint8_t id : cards) {
         // No bounds check for speed, assuming table is correct.
-        p = lookup_table_[p + card_val];
-    };
-
-        for (const auto& c : hole_cards) process_card(c);
-
-        for (const auto& c : board_cards) process_card(c);
-
-    
-
-        // The result is in p after 7 transitions.
-
-        // In our new harmonized HandRanks.dat, p is the actual final score.
-
-        return p;
+        p = lookup_table_[p + card_tables::kTwoPlusTwo[id]];
+    }
 
+    // After 7 transitions p is the final score (our harmonized HandRanks.dat
+    // stores encode_score values). 5- and 6-card states keep their score
+    // in slot 0 of the node, reached with one more lookup.
+    if (cards.size() < 7) {
+        p = lookup_table_[p];
     }
+    return p;
+}
 
-    
+int32_t TwoPlusTwoEvaluator::evaluate_fallback(const State& state) const {
+    uint8_t ids[kMaxHandCards];
+    size_t n = 0;
+    for (uint64_t cards = state.cards; cards && n < kMaxHandCards; cards &= cards - 1) {
+        ids[n++] = static_cast<uint8_t>(std::countr_zero(cards));
+    }
+    return evaluate_fallback(CardIds(ids, n));
+}
 
-int32_t TwoPlusTwoEvaluator::evaluate_fallback(const std::vector<Card>& hole, const std::vector<Card>& board) const {
+int32_t TwoPlusTwoEvaluator::evaluate_fallback(CardIds cards) const {
     // Correct fallback evaluation logic
     uint32_t ranks_mask = 0;
     uint8_t suit_counts[4] = {0};
     uint32_t suit_masks[4] = {0};
     uint8_t rank_counts[15] = {0};
 
-    auto process_card = [&](const Card& c) {
-        int r = c.rank;
-        int s = c.suit;
+    for (uint8_t id : cards) {
+        int r = card_tables::kRank[id];
+        int s = card_tables::kSuit[id];
         ranks_mask |= (1 << (r - 2));
         suit_counts[s]++;
         suit_masks[s] |= (1 << (r - 2));
         rank_counts[r]++;
-    };
-
-    for (const auto& c : hole) process_card(c);
-    for (const auto& c : board) process_card(c);
+    }
 
     // 1. Flush Check
     for (int s = 0; s < 4; s++) {
@@ -135,8 +141,4 @@ int32_t TwoPlusTwoEvaluator::evaluate_fallback(const std::vector<Card>& hole, co
 
     return 0;
 }
-
-void TwoPlusTwoEvaluator::prefetch(const std::vector<Card>& cards) const {
-    // __builtin_prefetch
-}
 }  // namespace poker_engine
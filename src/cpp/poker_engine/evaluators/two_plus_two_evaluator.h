@@ -2,7 +2,10 @@
 #define EVALUATORS_TWO_PLUS_TWO_EVALUATOR_H
 
 #include "core/card.h"
+#include "evaluator_interface.h"
+#include "hand_ranks_table.h"
 #include "hand_types.h"
+#include <memory>
 #include <vector>
 
 namespace poker_engine {
@@ -15,18 +18,88 @@ class TwoPlusTwoEvaluator {
   int32_t evaluate_hand(const std::vector<Card>& hole_cards,
                         const std::vector<Card>& board_cards) const;
 
+  // Evaluate 5-7 card ids without allocating (see evaluator_interface.h)
+  int32_t evaluate(CardIds cards) const;
+
+  // Partial state: the table node the walk has reached after the cards so
+  // far, plus a mask of them for the card count and the fallback (see
+  // IncrementalEvaluator in evaluator_interface.h). The node does not
+  // depend on the cards' order.
+  struct State {
+    int32_t node = 53;
+    int32_t count = 0;
+    uint64_t cards = 0;
+  };
+  State add(State state, uint8_t id) const {
+    if (table_loaded_) state.node = lookup_table_[state.node + card_tables::kTwoPlusTwo[id]];
+    state.count++;
+    state.cards |= 1ULL << id;
+    return state;
+  }
+  int32_t evaluate(const State& state) const {
+    if (!table_loaded_) return evaluate_fallback(state);
+    // 5- and 6-card states keep their score in slot 0, as in evaluate()
+    return state.count < 7 ? lookup_table_[state.node] : state.node;
+  }
+
+  // Evaluates `count` 7-card hands (`hands[h]`, card ids) into `results`,
+  // kInterleave walks at a time. A lone walk is seven dependent misses
+  // into a table far larger than cache; side by side, each step advances
+  // every walk of the group and prefetches the node its next card reads,
+  // so the group's misses overlap (PREFETCHING). Same values as evaluate().
+  template <int kInterleave>
+  void evaluate_interleaved(const uint8_t (*hands)[kMaxHandCards], int count,
+                            int32_t* results) const;
+
+  // The mapped table, or null when evaluating with the fallback
+  const HandRanksTable* table() const { return table_.get(); }
+
  private:
-  void load_table(const char* filename);
-  void prefetch(const std::vector<Card>& cards) const;
+  template <int kInterleave>
+  void walk_interleaved(const uint8_t (*hands)[kMaxHandCards], int32_t* results) const;
 
   // Fallback logic for when table is missing
-  int32_t evaluate_fallback(const std::vector<Card>& hole,
-                            const std::vector<Card>& board) const;
+  int32_t evaluate_fallback(CardIds cards) const;
+  int32_t evaluate_fallback(const State& state) const;
 
-  std::vector<int32_t> lookup_table_;
+  // Mapped once per process and shared by every evaluator (see
+  // hand_ranks_table.h); null when the table is missing or invalid
+  std::shared_ptr<const HandRanksTable> table_;
+  const int32_t* lookup_table_ = nullptr;
   bool table_loaded_;
 };
 
+template <int kInterleave>
+void TwoPlusTwoEvaluator::evaluate_interleaved(const uint8_t (*hands)[kMaxHandCards], int count,
+                                               int32_t* results) const {
+  static_assert(kInterleave > 0, "at least one walk at a time");
+  int h = 0;
+  if (table_loaded_) {
+    for (; count - h >= kInterleave; h += kInterleave) {
+      walk_interleaved<kInterleave>(hands + h, results + h);
+    }
+  }
+  // The tail (or every hand, without the table) one at a time
+  for (; h < count; ++h) results[h] = evaluate(CardIds(hands[h], kMaxHandCards));
+}
+
+template <int kInterleave>
+void TwoPlusTwoEvaluator::walk_interleaved(const uint8_t (*hands)[kMaxHandCards],
+                                           int32_t* results) const {
+  int32_t p[kInterleave];
+  for (int w = 0; w < kInterleave; ++w) p[w] = 53;
+  for (size_t step = 0; step < kMaxHandCards; ++step) {
+    for (int w = 0; w < kInterleave; ++w) {
+      p[w] = lookup_table_[p[w] + card_tables::kTwoPlusTwo[hands[w][step]]];
+      // The last step's value is the score, not a node
+      if (step + 1 < kMaxHandCards) {
+        __builtin_prefetch(lookup_table_ + p[w] + card_tables::kTwoPlusTwo[hands[w][step + 1]]);
+      }
+    }
+  }
+  for (int w = 0; w < kInterleave; ++w) results[w] = p[w];
+}
+
 }  // namespace poker_engine
 
 #endif  // EVALUATORS_TWO_PLUS_TWO_EVALUATOR_H
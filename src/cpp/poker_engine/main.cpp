@@ -1,6 +1,9 @@
 #include "api/server.h"
+#include "engine/evaluator_registry.h"
+#include <chrono>
 #include <iostream>
 #include <signal.h>
+#include <thread>
 
 volatile bool running = true;
 
@@ -20,6 +23,16 @@ int main(int argc, char* argv[]) {
         port = std::stoi(argv[1]);
     }
 
+    // Warm the evaluators while the server comes up; /health reports
+    // ready once they are
+    std::thread([] {
+        const auto start = std::chrono::steady_clock::now();
+        poker_engine::EvaluatorRegistry::warm_up();
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "Evaluators warm after " << ms << " ms" << std::endl;
+    }).detach();
+
     std::cout << "Starting API server on port " << port << "..." << std::endl;
 
     try {
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "../core/philox.h"
+#include "../engine/alias_table.h"
+
+using namespace poker_engine;
+
+TEST(AliasTableTest, DrawsEachIndexInProportionToItsWeight) {
+    const std::vector<double> weights = {1.0, 0.0, 3.0, 0.5, 5.5};
+    const AliasTable table(weights);
+    ASSERT_EQ(table.size(), weights.size());
+
+    Philox4x32 rng(7);
+    constexpr int kDraws = 1000000;
+    std::vector<int> counts(weights.size());
+    for (int i = 0; i < kDraws; ++i) {
+        const uint32_t column = static_cast<uint32_t>((uint64_t{rng()} * weights.size()) >> 32);
+        counts[table.sample(column, rng())]++;
+    }
+
+    // A weight of 0 is never drawn; the rest within a few standard errors
+    EXPECT_EQ(counts[1], 0);
+    for (size_t i = 0; i < weights.size(); ++i) {
+        EXPECT_NEAR(counts[i] / static_cast<double>(kDraws), weights[i] / 10.0, 0.003) << i;
+    }
+}
+
+TEST(AliasTableTest, EqualWeightsKeepEveryColumn) {
+    const AliasTable table(std::vector<double>(6, 2.0));
+    for (uint32_t column = 0; column < 6; ++column) {
+        EXPECT_EQ(table.sample(column, 0u), column);
+        EXPECT_EQ(table.sample(column, UINT32_MAX), column);
+    }
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "../core/deck.h"
+#include "../evaluators/naive_evaluator.h"
+#include "../evaluators/cactus_kev_evaluator.h"
+#include "../evaluators/ph_evaluator.h"
+#include "../evaluators/two_plus_two_evaluator.h"
+#include "../evaluators/omp_eval.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counts every global operator new in this test binary. Replacing the
+// global allocation functions is process-wide, so they only count and
+// forward to malloc/free.
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace poker_engine {
+
+class AllocationTest : public ::testing::Test {
+ protected:
+  static constexpr int kNumHands = 2000;
+
+  void SetUp() override {
+    Deck deck(99);
+    for (int i = 0; i < kNumHands; ++i) {
+      deck.reset();
+      std::array<uint8_t, 7> ids;
+      for (auto& id : ids) id = card_id(deck.draw_random());
+      hands_.push_back(ids);
+    }
+  }
+
+  // Heap allocations made while scoring every hand via evaluate()
+  template <HandEvaluator E>
+  size_t allocations_per_pass(const E& evaluator) {
+    volatile int32_t sink = 0;
+    size_t before = g_allocations.load();
+    for (const auto& ids : hands_) {
+      sink = evaluator.evaluate(CardIds(ids.data(), ids.size()));
+      sink = evaluator.evaluate(CardIds(ids.data(), 5));
+      sink = evaluator.evaluate(CardIds(ids.data(), 6));
+    }
+    (void)sink;
+    return g_allocations.load() - before;
+  }
+
+  std::vector<std::array<uint8_t, 7>> hands_;
+};
+
+TEST_F(AllocationTest, CounterSeesAllocations) {
+  // A direct call, which (unlike a new-expression) cannot be elided
+  size_t before = g_allocations.load();
+  void* ptr = ::operator new(64);
+  ::operator delete(ptr);
+  EXPECT_EQ(g_allocations.load() - before, 1u);
+}
+
+TEST_F(AllocationTest, EvaluatorsDoNotAllocate) {
+  NaiveEvaluator naive;
+  CactusKevEvaluator cactus;
+  PHEvaluator ph;
+  TwoPlusTwoEvaluator tpt;
+  OMPEval omp;
+
+  EXPECT_EQ(allocations_per_pass(naive), 0u) << "Naive";
+  EXPECT_EQ(allocations_per_pass(cactus), 0u) << "Cactus Kev";
+  EXPECT_EQ(allocations_per_pass(ph), 0u) << "PH Evaluator";
+  EXPECT_EQ(allocations_per_pass(tpt), 0u) << "Two Plus Two";
+  EXPECT_EQ(allocations_per_pass(omp), 0u) << "OMP Eval";
+}
+
+TEST_F(AllocationTest, VectorWrapperDoesNotAllocate) {
+  OMPEval omp;
+  std::vector<Card> hole = {card_from_id(hands_[0][0]), card_from_id(hands_[0][1])};
+  std::vector<Card> board;
+  for (int i = 2; i < 7; ++i) board.push_back(card_from_id(hands_[0][i]));
+
+  size_t before = g_allocations.load();
+  volatile int32_t sink = omp.evaluate_hand(hole, board);
+  (void)sink;
+  EXPECT_EQ(g_allocations.load() - before, 0u);
+}
+
+TEST_F(AllocationTest, SpanMatchesVectorInterface) {
+  NaiveEvaluator naive;
+  CactusKevEvaluator cactus;
+  PHEvaluator ph;
+  OMPEval omp;
+
+  for (int h = 0; h < 200; ++h) {
+    const auto& ids = hands_[h];
+    std::vector<Card> hole = {card_from_id(ids[0]), card_from_id(ids[1])};
+    std::vector<Card> board;
+    for (int i = 2; i < 7; ++i) board.push_back(card_from_id(ids[i]));
+    CardIds cards(ids.data(), ids.size());
+
+    int32_t expected = naive.evaluate_hand(hole, board);
+    EXPECT_EQ(naive.evaluate(cards), expected);
+    EXPECT_EQ(cactus.evaluate(cards), expected);
+    EXPECT_EQ(ph.evaluate(cards), expected);
+    EXPECT_EQ(omp.evaluate(cards), expected);
+  }
+}
+
+}  // namespace poker_engine
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "../engine/board_rank_cache.h"
+#include "../evaluators/omp_eval.h"
+
+using namespace poker_engine;
+
+namespace {
+
+constexpr uint8_t id_of(int rank, int suit) { return static_cast<uint8_t>((rank - 2) * 4 + suit); }
+
+// Fills vectors with OMPEval one combo at a time and counts the fills
+struct CountingFill {
+    OMPEval evaluator;
+    std::atomic<int> calls{0};
+
+    BoardRankCache::Fill fn() {
+        return [this](const std::array<uint8_t, 5>& board, BoardRanks& ranks) {
+            calls++;
+            ranks.fill(0);
+            uint8_t ids[7] = {0, 0, board[0], board[1], board[2], board[3], board[4]};
+            for (int combo = 0; combo < kNumHandCombos; ++combo) {
+                ids[0] = hand_index_tables::kComboCards[combo][0];
+                ids[1] = hand_index_tables::kComboCards[combo][1];
+                bool on_board = false;
+                for (uint8_t b : board) on_board |= (b == ids[0] || b == ids[1]);
+                if (!on_board) ranks[combo] = evaluator.evaluate(CardIds(ids, 7));
+            }
+        };
+    }
+};
+
+}  // namespace
+
+TEST(BoardRankCacheTest, SuitRelabellingsShareACanonicalBoard) {
+    // As Kh 7d 2c 9s and the same board with spades and hearts swapped
+    const std::array<uint8_t, 5> board = {id_of(14, 3), id_of(13, 2), id_of(7, 1), id_of(2, 0), id_of(9, 3)};
+    const std::array<uint8_t, 5> swapped = {id_of(14, 2), id_of(13, 3), id_of(7, 1), id_of(2, 0), id_of(9, 2)};
+    const std::array<uint8_t, 5> other = {id_of(14, 3), id_of(13, 3), id_of(7, 1), id_of(2, 0), id_of(9, 3)};
+    EXPECT_EQ(canonicalize_board(board).mask, canonicalize_board(swapped).mask);
+    EXPECT_NE(canonicalize_board(board).mask, canonicalize_board(other).mask);
+    EXPECT_EQ(__builtin_popcountll(canonicalize_board(board).mask), 5);
+}
+
+TEST(BoardRankCacheTest, RelabelledHitMatchesTheEvaluator) {
+    BoardRankCache cache(8);
+    CountingFill fill;
+    const std::array<uint8_t, 5> board = {id_of(14, 3), id_of(13, 2), id_of(7, 1), id_of(2, 0), id_of(9, 3)};
+    const std::array<uint8_t, 5> swapped = {id_of(14, 1), id_of(13, 0), id_of(7, 3), id_of(2, 2), id_of(9, 1)};
+
+    cache.get(0, board, fill.fn());
+    const auto ranks = cache.get(0, swapped, fill.fn());
+    EXPECT_EQ(fill.calls.load(), 1);
+    EXPECT_EQ(cache.stats().hits, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+
+    BoardRanks expected;
+    fill.fn()(swapped, expected);
+    EXPECT_EQ(*ranks, expected);
+}
+
+TEST(BoardRankCacheTest, EvictsTheLeastRecentlyUsedBoard) {
+    BoardRankCache cache(2);
+    CountingFill fill;
+    const std::array<uint8_t, 5> a = {id_of(2, 0), id_of(3, 1), id_of(4, 2), id_of(8, 3), id_of(12, 0)};
+    const std::array<uint8_t, 5> b = {id_of(5, 0), id_of(6, 1), id_of(9, 2), id_of(10, 3), id_of(13, 0)};
+    const std::array<uint8_t, 5> c = {id_of(7, 0), id_of(7, 1), id_of(11, 2), id_of(14, 3), id_of(2, 0)};
+
+    cache.get(0, a, fill.fn());
+    const auto evicted = cache.get(0, b, fill.fn());
+    cache.get(0, a, fill.fn());
+    cache.get(0, c, fill.fn());
+    EXPECT_TRUE(cache.contains(0, a));
+    EXPECT_FALSE(cache.contains(0, b));
+    EXPECT_TRUE(cache.contains(0, c));
+    EXPECT_EQ(cache.stats().size, 2u);
+    // Evaluators have their own value scales, so they never share a vector
+    EXPECT_FALSE(cache.contains(1, a));
+
+    // Handed-out vectors outlive their eviction
+    EXPECT_GT((*evicted)[hand_combo_index(id_of(14, 0), id_of(14, 1))], 0);
+    EXPECT_EQ(fill.calls.load(), 3);
+}
+
+TEST(BoardRankCacheTest, RunoutRanksCoverEveryTurnCompletion) {
+    BoardRankCache cache(64);
+    CountingFill fill;
+    const std::vector<uint8_t> turn = {id_of(14, 3), id_of(10, 3), id_of(6, 2), id_of(6, 1)};
+    EXPECT_EQ(RunoutRanks::count(3), 1176);
+    EXPECT_EQ(RunoutRanks::count(0), 0);
+    EXPECT_EQ(RunoutRanks::missing(cache, 0, turn), 48);
+
+    ThreadPool pool(2);
+    RunoutRanks ranks(cache, 0, turn, fill.fn(), &pool);
+    EXPECT_EQ(RunoutRanks::missing(cache, 0, turn), 0);
+    // Swapping the two sixes' suits maps the turn to itself, so rivers
+    // of those suits share vectors
+    EXPECT_LT(fill.calls.load(), 48);
+
+    uint8_t ids[7] = {id_of(13, 3), id_of(12, 3), turn[0], turn[1], turn[2], turn[3], id_of(2, 3)};
+    const int32_t* vector = ranks.find(ids + 2);
+    ASSERT_NE(vector, nullptr);
+    EXPECT_EQ(vector[hand_combo_index(ids[0], ids[1])], fill.evaluator.evaluate(CardIds(ids, 7)));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../evaluators/cactus_kev_evaluator.h"
 #include "../evaluators/hand_types.h"
+#include "../evaluators/omp_eval.h"
 
 using namespace poker_engine;
 
@@ -36,3 +37,22 @@ TEST_F(CactusKevTest, EvaluatesHighCard) {
     EXPECT_LT(score, ONE_PAIR_MIN);
     EXPECT_EQ(get_hand_type(score), HandType::HIGH_CARD);
 }
+
+TEST_F(CactusKevTest, TablesScoreEveryFiveCardHand) {
+    // Flushes, unique5 and the perfect hash together cover all 2,598,960
+    OMPEval reference;
+    uint8_t ids[5];
+    int mismatches = 0;
+    for (ids[0] = 0; ids[0] < 52; ++ids[0])
+    for (ids[1] = ids[0] + 1; ids[1] < 52; ++ids[1])
+    for (ids[2] = ids[1] + 1; ids[2] < 52; ++ids[2])
+    for (ids[3] = ids[2] + 1; ids[3] < 52; ++ids[3])
+    for (ids[4] = ids[3] + 1; ids[4] < 52; ++ids[4]) {
+        const CardIds cards(ids, 5);
+        if (evaluator.evaluate(cards) != reference.evaluate(cards) && ++mismatches <= 5) {
+            ADD_FAILURE() << "ids " << int(ids[0]) << " " << int(ids[1]) << " " << int(ids[2])
+                          << " " << int(ids[3]) << " " << int(ids[4]);
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <chrono>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "../core/card.h"
 #include "../core/deck.h"
@@ -42,6 +45,52 @@ TEST_F(EvaluatorConsistencyTest, RandomHandsMatchNaive) {
   }
 }
 
+TEST_F(EvaluatorConsistencyTest, InterleavedTwoPlusTwoMatchesScalar) {
+  Deck deck;
+  // Not a multiple of the interleave, so the tail is walked alone
+  const int kNumHands = 1003;
+  std::vector<std::array<uint8_t, kMaxHandCards>> hands(kNumHands);
+  for (auto& hand : hands) {
+    deck.reset();
+    for (uint8_t& id : hand) id = card_id(deck.draw_random());
+  }
+  const auto* ids = reinterpret_cast<const uint8_t(*)[kMaxHandCards]>(hands.data());
+
+  std::vector<int32_t> one(kNumHands), eight(kNumHands);
+  tpt_.evaluate_interleaved<1>(ids, kNumHands, one.data());
+  tpt_.evaluate_interleaved<8>(ids, kNumHands, eight.data());
+  for (int h = 0; h < kNumHands; ++h) {
+    const int32_t expected = tpt_.evaluate(CardIds(hands[h].data(), kMaxHandCards));
+    EXPECT_EQ(one[h], expected) << "hand " << h;
+    EXPECT_EQ(eight[h], expected) << "hand " << h;
+  }
+}
+
+TEST_F(EvaluatorConsistencyTest, IncrementalStatesMatchEvaluate) {
+  Deck deck;
+  auto check = [&](const char* name, const auto& evaluator) {
+    for (int i = 0; i < 1000; ++i) {
+      deck.reset();
+      uint8_t ids[kMaxHandCards];
+      for (uint8_t& id : ids) id = card_id(deck.draw_random());
+
+      // A shared prefix, copied and finished two ways, in another order
+      typename std::remove_cvref_t<decltype(evaluator)>::State prefix{};
+      for (int c = 6; c >= 2; --c) prefix = evaluator.add(prefix, ids[c]);
+      EXPECT_EQ(evaluator.evaluate(prefix), evaluator.evaluate(CardIds(ids + 2, 5))) << name;
+      const auto six = evaluator.add(prefix, ids[1]);
+      EXPECT_EQ(evaluator.evaluate(six), evaluator.evaluate(CardIds(ids + 1, 6))) << name;
+      EXPECT_EQ(evaluator.evaluate(evaluator.add(six, ids[0])),
+                evaluator.evaluate(CardIds(ids, kMaxHandCards))) << name;
+    }
+  };
+  static_assert(IncrementalEvaluator<TwoPlusTwoEvaluator> && IncrementalEvaluator<OMPEval> &&
+                IncrementalEvaluator<PHEvaluator>);
+  check("Two Plus Two", tpt_);
+  check("OMP Eval", omp_);
+  check("PH Evaluator", ph_);
+}
+
 TEST_F(EvaluatorConsistencyTest, BenchmarkEvaluators) {
   Deck deck;
   const int kNumBenchmarks = 100000;
@@ -64,6 +113,7 @@ TEST_F(EvaluatorConsistencyTest, BenchmarkEvaluators) {
     std::chrono::duration<double> diff = end - start;
     std::cout << "[ BENCHMARK ] " << name << ": " 
               << (kNumBenchmarks / diff.count()) / 1e6 << "M evals/sec" << std::endl;
+    EXPECT_GT(sink, 0) << name;
   };
 
   benchmark("Naive         ", naive_);
@@ -71,6 +121,65 @@ TEST_F(EvaluatorConsistencyTest, BenchmarkEvaluators) {
   benchmark("PH Evaluator  ", ph_);
   benchmark("Two Plus Two  ", tpt_);
   benchmark("OMP Eval      ", omp_);
+
+  // Same hands through the SoA batch kernel
+  const int lanes = omp_.batch_size();
+  std::vector<HandBatch> batches(kNumBenchmarks / lanes);
+  for (size_t n = 0; n < batches.size(); ++n) {
+    for (int b = 0; b < lanes; ++b) {
+      const size_t i = n * lanes + b;
+      for (int c = 0; c < 2; ++c) {
+        batches[n].ranks[c][b] = holes[i][c].rank;
+        batches[n].suits[c][b] = holes[i][c].suit;
+      }
+      for (int c = 0; c < 5; ++c) {
+        batches[n].ranks[c + 2][b] = boards[i][c].rank;
+        batches[n].suits[c + 2][b] = boards[i][c].suit;
+      }
+    }
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  int32_t results[SIMDConfig::kMaxBatchSize];
+  volatile int32_t sink = 0;
+  for (const auto& batch : batches) {
+    omp_.evaluate_batch(batch, results);
+    sink = results[0];
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> diff = end - start;
+  std::cout << "[ BENCHMARK ] OMP Eval batch (" << SIMDHelper::LevelName(omp_.simd_level())
+            << "): " << (batches.size() * lanes / diff.count()) / 1e6
+            << "M evals/sec" << std::endl;
+  EXPECT_GT(sink, 0);
+}
+
+TEST_F(EvaluatorConsistencyTest, BenchmarkInterleavedTwoPlusTwo) {
+  // Random hands touch nodes all over the table, so most steps miss cache
+  // (unless the table is missing and every walk takes the fallback)
+  Deck deck;
+  const int kNumBenchmarks = 1 << 20;
+  std::vector<std::array<uint8_t, kMaxHandCards>> hands(kNumBenchmarks);
+  for (auto& hand : hands) {
+    deck.reset();
+    for (uint8_t& id : hand) id = card_id(deck.draw_random());
+  }
+  const auto* ids = reinterpret_cast<const uint8_t(*)[kMaxHandCards]>(hands.data());
+  std::vector<int32_t> results(kNumBenchmarks);
+
+  auto sweep = [&]<int... kInterleave>(std::integer_sequence<int, kInterleave...>) {
+    auto benchmark = [&]<int K>() {
+      auto start = std::chrono::high_resolution_clock::now();
+      tpt_.evaluate_interleaved<K>(ids, kNumBenchmarks, results.data());
+      auto end = std::chrono::high_resolution_clock::now();
+      std::chrono::duration<double> diff = end - start;
+      std::cout << "[ BENCHMARK ] Two Plus Two, " << K << " walks at a time: "
+                << (kNumBenchmarks / diff.count()) / 1e6 << "M evals/sec" << std::endl;
+    };
+    (benchmark.template operator()<kInterleave>(), ...);
+  };
+  sweep(std::integer_sequence<int, 1, 2, 4, 8, 16, 32, 64>{});
+
+  EXPECT_GT(results[kNumBenchmarks - 1], 0);
 }
 
 } // namespace poker_engine
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "../engine/evaluator_registry.h"
+
+using namespace poker_engine;
+
+TEST(EvaluatorRegistryTest, OneSharedInstancePerProcess) {
+    const EvaluatorRegistry& registry = EvaluatorRegistry::instance();
+    EXPECT_EQ(&registry, &EvaluatorRegistry::instance());
+
+    // Borrowed evaluators score like fresh ones
+    OMPEval omp;
+    const uint8_t ids[] = {48, 49, 0, 13, 30, 7, 22};  // AhAd, 2h, 5d, 9c, 3s, 7c
+    const CardIds cards(ids, 7);
+    EXPECT_EQ(registry.omp().evaluate(cards), omp.evaluate(cards));
+    EXPECT_EQ(registry.cactus_kev().evaluate(cards), registry.omp().evaluate(cards));
+    EXPECT_EQ(registry.ph().evaluate(cards), registry.omp().evaluate(cards));
+}
+
+TEST(EvaluatorRegistryTest, WarmUpRunsOnceAndReportsReady) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) threads.emplace_back([] { EvaluatorRegistry::warm_up(); });
+    for (auto& thread : threads) thread.join();
+    EXPECT_TRUE(EvaluatorRegistry::ready());
+    EvaluatorRegistry::warm_up();
+    EXPECT_TRUE(EvaluatorRegistry::ready());
+}
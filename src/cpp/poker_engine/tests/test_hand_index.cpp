@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "../core/hand_index.h"
+#include "../engine/hand_accumulator.h"
+#include "../evaluators/naive_evaluator.h"
+
+using namespace poker_engine;
+
+TEST(HandIndexTest, ClassesMatchClassifyHoleCards) {
+    NaiveEvaluator evaluator;
+    std::set<int> seen;
+    for (uint8_t a = 0; a < 52; ++a) {
+        for (uint8_t b = 0; b < 52; ++b) {
+            if (a == b) continue;
+            const Card ca = card_from_id(a);
+            const Card cb = card_from_id(b);
+            const int hand_class = hand_class_of(a, b);
+            ASSERT_GE(hand_class, 0);
+            ASSERT_LT(hand_class, kNumHandClasses);
+            EXPECT_EQ(hand_class, hand_class_of(b, a));
+            EXPECT_EQ(hand_class_name(hand_class), evaluator.classify_hole_cards({ca, cb}));
+            seen.insert(hand_class);
+        }
+    }
+    EXPECT_EQ(seen.size(), static_cast<size_t>(kNumHandClasses));
+}
+
+TEST(HandIndexTest, GridLayout) {
+    EXPECT_EQ(hand_class_name(0), "AA");
+    EXPECT_EQ(hand_class_name(1), "AKs");
+    EXPECT_EQ(hand_class_name(13), "AKo");
+    EXPECT_EQ(hand_class_name(168), "22");
+    EXPECT_EQ(hand_class_index(7, 2, false), 12 * 13 + 7);
+}
+
+TEST(HandIndexTest, CombosRoundTrip) {
+    std::set<int> seen;
+    for (uint8_t hi = 1; hi < 52; ++hi) {
+        for (uint8_t lo = 0; lo < hi; ++lo) {
+            const int combo = hand_combo_index(lo, hi);
+            EXPECT_EQ(combo, hand_combo_index(hi, lo));
+            ASSERT_LT(combo, kNumHandCombos);
+            EXPECT_EQ(hand_index_tables::kComboCards[combo][0], lo);
+            EXPECT_EQ(hand_index_tables::kComboCards[combo][1], hi);
+            EXPECT_EQ(hand_index_tables::kClassOfCombo[combo], hand_class_of(lo, hi));
+            seen.insert(combo);
+        }
+    }
+    EXPECT_EQ(seen.size(), static_cast<size_t>(kNumHandCombos));
+}
+
+TEST(HandAccumulatorTest, RecordsAndMerges) {
+    const int aks = hand_class_of(Card(14, 0), Card(13, 0));
+    const int32_t pair = encode_score(ONE_PAIR, {9, 14, 13, 5});
+    const int32_t high = encode_score(HIGH_CARD, {14, 13, 9, 5, 3});
+
+    HandAccumulator a;
+    a.record(aks, pair, high);
+    a.record(aks, high, high);
+    HandAccumulator b;
+    b.record(aks, high, pair);
+    b.record(HandAccumulator::kNoOpponent, pair, 0);
+    a += b;
+
+    EXPECT_EQ(a[aks].wins, 1u);
+    EXPECT_EQ(a[aks].ties, 1u);
+    EXPECT_EQ(a[aks].losses, 1u);
+    EXPECT_EQ(a[aks].total, 3u);
+    EXPECT_EQ(a[aks].win_method_matrix[ONE_PAIR][HIGH_CARD], 1u);
+    EXPECT_EQ(a[aks].loss_method_matrix[ONE_PAIR][HIGH_CARD], 1u);
+    EXPECT_EQ(HandAccumulator::slot_name(HandAccumulator::kNoOpponent), "??");
+
+    OutcomeCounts total = a.total();
+    EXPECT_EQ(total.total, 4u);
+    EXPECT_EQ(total.wins, 2u);
+
+    EquityResult result;
+    add_to_result(total, result);
+    EXPECT_DOUBLE_EQ(result.equity, 2.5 / 4);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../evaluators/hand_ranks_table.h"
+
+using namespace poker_engine;
+
+namespace {
+
+// A table file of `entries` in this process's temp directory, with the
+// trailer unless `trailer` is false; removed by the fixture
+class HandRanksTableTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::filesystem::remove(path_); }
+
+    const std::string& write(const std::vector<int32_t>& entries, bool trailer = true) {
+        std::string bytes(reinterpret_cast<const char*>(entries.data()),
+                          entries.size() * sizeof(int32_t));
+        if (trailer) {
+            HandRanksTrailer t;
+            std::memcpy(t.magic, kHandRanksMagic, sizeof(t.magic));
+            t.entries = entries.size();
+            t.checksum = hand_ranks_checksum(entries.data(), entries.size());
+            bytes.append(reinterpret_cast<const char*>(&t), sizeof(t));
+        }
+        return write_bytes(bytes);
+    }
+
+    const std::string& write_bytes(const std::string& bytes) {
+        FILE* file = std::fopen(path_.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+        return path_;
+    }
+
+    std::string read_back() const {
+        std::string bytes(std::filesystem::file_size(path_), '\0');
+        FILE* file = std::fopen(path_.c_str(), "rb");
+        EXPECT_EQ(std::fread(bytes.data(), 1, bytes.size(), file), bytes.size());
+        std::fclose(file);
+        return bytes;
+    }
+
+    std::string path_ = (std::filesystem::temp_directory_path() /
+                         ("hand_ranks_test_" + std::to_string(getpid()) + ".dat")).string();
+};
+
+std::vector<int32_t> sample_entries(size_t n) {
+    std::vector<int32_t> entries(n);
+    for (size_t i = 0; i < n; ++i) entries[i] = static_cast<int32_t>(i * 2654435761u);
+    return entries;
+}
+
+}  // namespace
+
+TEST_F(HandRanksTableTest, MapsAValidTable) {
+    const std::vector<int32_t> entries = sample_entries(1000);
+    const auto table = HandRanksTable::open(write(entries));
+    ASSERT_EQ(table->size(), entries.size());
+    EXPECT_EQ(std::memcmp(table->data(), entries.data(), entries.size() * sizeof(int32_t)), 0);
+    EXPECT_EQ(table->checksum(), hand_ranks_checksum(entries.data(), entries.size()));
+    // Mapped on a huge page boundary
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(table->data()) % (2 << 20), 0u);
+}
+
+TEST_F(HandRanksTableTest, RejectsTruncatedAndCorruptTables) {
+    const std::vector<int32_t> entries = sample_entries(1001);
+    write(entries);
+    const std::string whole = read_back();
+
+    // Cut short: the trailer is gone, and it is not a full legacy table
+    write_bytes(whole.substr(0, whole.size() - 4));
+    EXPECT_THROW(HandRanksTable::open(path_), std::runtime_error);
+    write_bytes(whole.substr(0, whole.size() / 2));
+    EXPECT_THROW(HandRanksTable::open(path_), std::runtime_error);
+
+    // One flipped bit
+    std::string flipped = whole;
+    flipped[1234] ^= 0x10;
+    write_bytes(flipped);
+    EXPECT_THROW(HandRanksTable::open(path_), std::runtime_error);
+
+    // A trailer that claims more entries than the file holds
+    std::string lying = whole;
+    const uint64_t more = entries.size() + 1;
+    std::memcpy(&lying[lying.size() - sizeof(HandRanksTrailer) + 8], &more, sizeof(more));
+    write_bytes(lying);
+    EXPECT_THROW(HandRanksTable::open(path_), std::runtime_error);
+
+    write(entries, false);
+    EXPECT_THROW(HandRanksTable::open(path_), std::runtime_error);
+    EXPECT_THROW(HandRanksTable::open(path_ + ".missing"), std::runtime_error);
+    EXPECT_EQ(HandRanksTable::shared(path_ + ".missing"), nullptr);
+}
+
+TEST_F(HandRanksTableTest, SharedMapsEachPathOnce) {
+    const auto first = HandRanksTable::shared(write(sample_entries(64)));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(HandRanksTable::shared(path_), first);
+}
@@ -38,3 +38,27 @@ TEST(HandTypesTest, OptimizationFlagsExist) {
     flags = OptimizationFlags::PREFETCHING;
     EXPECT_TRUE(flags & OptimizationFlags::PREFETCHING);
 }
+
+TEST(HandTypesTest, ParsesEvaluatorNames) {
+    EXPECT_EQ(parse_evaluator_type("naive"), EvaluatorType::NAIVE);
+    EXPECT_EQ(parse_evaluator_type("CACTUS_KEV"), EvaluatorType::CACTUS_KEV);
+    EXPECT_EQ(parse_evaluator_type("ph_evaluator"), EvaluatorType::PH_EVALUATOR);
+    EXPECT_EQ(parse_evaluator_type("Perfect_Hash"), EvaluatorType::PH_EVALUATOR);
+    EXPECT_EQ(parse_evaluator_type("TWO_PLUS_TWO"), EvaluatorType::TWO_PLUS_TWO);
+    EXPECT_EQ(parse_evaluator_type("omp"), EvaluatorType::OMP_EVAL);
+    EXPECT_EQ(parse_evaluator_type("OMP_EVAL"), EvaluatorType::OMP_EVAL);
+    // Unknown names keep the engine's old fallback
+    EXPECT_EQ(parse_evaluator_type("quantum"), EvaluatorType::NAIVE);
+    EXPECT_EQ(parse_evaluator_type(""), EvaluatorType::NAIVE);
+}
+
+TEST(HandTypesTest, ParsesOptimizationNames) {
+    EXPECT_EQ(parse_optimization_flags({}), OptimizationFlags::NONE);
+    EXPECT_EQ(parse_optimization_flags({"MULTITHREADING", "simd"}),
+              OptimizationFlags::MULTITHREADING | OptimizationFlags::SIMD);
+    EXPECT_EQ(parse_optimization_flags({"Prefetching", "PERFECT_HASH", "bogus"}),
+              OptimizationFlags::PREFETCHING | OptimizationFlags::PERFECT_HASH);
+    EXPECT_EQ(parse_optimization_flags({"exhaustive"}), OptimizationFlags::EXHAUSTIVE);
+    EXPECT_EQ(parse_optimization_flags({"board_major"}), OptimizationFlags::BOARD_MAJOR);
+    EXPECT_EQ(parse_optimization_flags({"Board_Cache"}), OptimizationFlags::BOARD_CACHE);
+}
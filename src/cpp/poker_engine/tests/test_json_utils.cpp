@@ -66,3 +66,80 @@ TEST(JsonUtilsTest, ParseCreateJobRequest_Defaults) {
     EXPECT_EQ(num_workers, 0);
     EXPECT_TRUE(optimizations.empty());
 }
+
+TEST(JsonUtilsTest, ParseCreateJobRequest_Seed) {
+    std::string json_str = R"({
+        "range_spec": {
+            "AKs": [{"rank": 14, "suit": 0}, {"rank": 13, "suit": 0}]
+        },
+        "num_workers": 2,
+        "seed": 18446744073709551615
+    })";
+
+    JobRequest request;
+    EXPECT_TRUE(parse_create_job_request(json_str, request));
+    ASSERT_TRUE(request.seed.has_value());
+    EXPECT_EQ(*request.seed, 18446744073709551615ull);
+    EXPECT_EQ(request.num_workers, 2);
+    EXPECT_EQ(request.range_spec.at("AKs").size(), 2);
+
+    JobRequest unseeded;
+    EXPECT_TRUE(parse_create_job_request(R"({"range_spec": {}})", unseeded));
+    EXPECT_FALSE(unseeded.seed.has_value());
+
+    JobRequest invalid;
+    EXPECT_FALSE(parse_create_job_request(
+        R"({"range_spec": {}, "seed": -1})", invalid));
+}
+
+TEST(JsonUtilsTest, ParseCreateJobRequest_PrecisionTarget) {
+    JobRequest by_std_error;
+    EXPECT_TRUE(parse_create_job_request(
+        R"({"range_spec": {}, "target_std_error": 0.005})", by_std_error));
+    ASSERT_TRUE(by_std_error.target_std_error.has_value());
+    EXPECT_DOUBLE_EQ(*by_std_error.target_std_error, 0.005);
+
+    JobRequest by_half_width;
+    EXPECT_TRUE(parse_create_job_request(
+        R"({"range_spec": {}, "target_ci_half_width": 0.0196})", by_half_width));
+    ASSERT_TRUE(by_half_width.target_std_error.has_value());
+    EXPECT_DOUBLE_EQ(*by_half_width.target_std_error, 0.01);
+
+    JobRequest untargeted;
+    EXPECT_TRUE(parse_create_job_request(R"({"range_spec": {}})", untargeted));
+    EXPECT_FALSE(untargeted.target_std_error.has_value());
+
+    JobRequest invalid;
+    EXPECT_FALSE(parse_create_job_request(
+        R"({"range_spec": {}, "target_std_error": 0})", invalid));
+}
+
+TEST(JsonUtilsTest, ParseCreateJobRequest_Schedule) {
+    JobRequest neyman;
+    EXPECT_TRUE(parse_create_job_request(R"({"range_spec": {}, "schedule": "Neyman"})", neyman));
+    EXPECT_EQ(parse_schedule(neyman.schedule), Schedule::NEYMAN);
+
+    JobRequest unscheduled;
+    EXPECT_TRUE(parse_create_job_request(R"({"range_spec": {}})", unscheduled));
+    EXPECT_EQ(unscheduled.schedule, "uniform");
+    EXPECT_EQ(parse_schedule(unscheduled.schedule), Schedule::UNIFORM);
+}
+
+TEST(JsonUtilsTest, ParseCreateJobRequest_RangeNotation) {
+    JobRequest request;
+    EXPECT_TRUE(parse_create_job_request(
+        R"({"range": "TT+, AKs", "opponent_ranges": ["QQ+, AKo:0.5"]})", request));
+    ASSERT_TRUE(request.range.has_value());
+    EXPECT_EQ(request.range->combos.count(), 5 * 6 + 4);
+    EXPECT_TRUE(request.range_spec.empty());
+    ASSERT_EQ(request.opponent_ranges.size(), 1u);
+    EXPECT_EQ(request.opponent_ranges[0].size(), 3u * 6u + 12u);
+
+    JobRequest no_hands;
+    EXPECT_FALSE(parse_create_job_request(R"({"num_opponents": 1})", no_hands));
+    JobRequest bad_notation;
+    EXPECT_FALSE(parse_create_job_request(R"({"range": "AKx"})", bad_notation));
+    JobRequest bad_opponents;
+    EXPECT_FALSE(parse_create_job_request(R"({"range": "AA", "opponent_ranges": ["ZZ"]})",
+                                          bad_opponents));
+}
@@ -1,4 +1,11 @@
 #include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
 #include "../engine/equity_engine.h"
 
 using namespace poker_engine;
@@ -20,3 +27,913 @@ TEST(EquityEngineTest, MultithreadingWorks) {
     EXPECT_TRUE(results.count("AA"));
     EXPECT_GT(results["AA"].total_simulations, 0);
 }
+
+TEST(EquityEngineTest, SimdPathHandlesMultipleOpponents) {
+    EquityEngine engine("test_mode");
+
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.board = {};
+    request.num_opponents = 2;
+    request.num_simulations = 20000;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"simd"};
+    request.num_workers = 1;
+
+    auto results = engine.calculate_range_equity(request);
+
+    ASSERT_TRUE(results.count("AA"));
+    EXPECT_EQ(results["AA"].total_simulations, 20000u);
+    // AA vs two random hands is ~73.5%
+    EXPECT_NEAR(results["AA"].equity, 0.735, 0.03);
+}
+
+TEST(EquityEngineTest, PrefetchingDealsAndScoresLikeTheScalarPath) {
+    for (int num_opponents : {1, 3}) {
+        JobRequest request;
+        request.range_spec["AKs"] = {Card(14, 0), Card(13, 0)};
+        request.board = {Card(9, 2), Card(5, 1), Card(2, 2)};
+        request.num_opponents = num_opponents;
+        // Leaves a chunk tail shorter than one interleaved batch
+        request.num_simulations = 10007;
+        request.algorithm = "two_plus_two";
+        request.num_workers = 1;
+        request.seed = 11;
+
+        auto scalar = EquityEngine("test_mode").calculate_range_equity(request);
+        request.optimizations = {"prefetching"};
+        auto interleaved = EquityEngine("test_mode").calculate_range_equity(request);
+
+        EXPECT_EQ(interleaved["AKs"].total_simulations, 10007u);
+        EXPECT_EQ(interleaved["AKs"].wins, scalar["AKs"].wins) << num_opponents;
+        EXPECT_EQ(interleaved["AKs"].ties, scalar["AKs"].ties) << num_opponents;
+    }
+}
+
+TEST(EquityEngineTest, IncrementalEvaluatorsScoreLikeFullEvaluation) {
+    JobRequest request;
+    request.range_spec["AKs"] = {Card(14, 0), Card(13, 0)};
+    request.range_spec["77"] = {Card(7, 1), Card(7, 3)};
+    request.board = {Card(9, 2), Card(5, 1), Card(2, 2)};
+    request.num_opponents = 2;
+    // 10240 simulations per hand: 10 chunks of kSimulationsPerChunk (1024),
+    // each a whole number of kInterleavedDeals (32) batches, so prefetching
+    // walks every hand in full and leaves no tail to the incremental path.
+    // Keep this a multiple of 2 * 1024 if either constant changes.
+    request.num_simulations = 20480;
+    request.num_workers = 1;
+    request.seed = 3;
+
+    auto expect_same = [](auto& incremental, auto& full, const char* algorithm) {
+        for (const char* hand : {"AKs", "77"}) {
+            EXPECT_EQ(incremental[hand].wins, full[hand].wins) << algorithm << " " << hand;
+            EXPECT_EQ(incremental[hand].ties, full[hand].ties) << algorithm << " " << hand;
+        }
+    };
+
+    // Naive has no partial state, so it evaluates every hand in full
+    request.algorithm = "naive";
+    auto full = EquityEngine("test_mode").calculate_range_equity(request);
+    for (const char* algorithm : {"omp_eval", "ph_evaluator"}) {
+        request.algorithm = algorithm;
+        auto incremental = EquityEngine("test_mode").calculate_range_equity(request);
+        expect_same(incremental, full, algorithm);
+    }
+
+    // Two Plus Two against its own full walks, which without HandRanks.dat
+    // are the approximate fallback rather than naive's values
+    request.algorithm = "two_plus_two";
+    auto incremental = EquityEngine("test_mode").calculate_range_equity(request);
+    request.optimizations = {"prefetching"};
+    auto walked = EquityEngine("test_mode").calculate_range_equity(request);
+    expect_same(incremental, walked, "two_plus_two");
+}
+
+TEST(EquityEngineTest, SeededJobIsIdenticalForAnyWorkerCount) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.range_spec["T9s"] = {Card(10, 2), Card(9, 2)};
+    request.board = {Card(9, 0), Card(5, 1), Card(2, 2)};
+    request.num_opponents = 2;
+    request.num_simulations = 9000;  // not a multiple of the chunk size
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 12345;
+
+    auto run = [](const JobRequest& req) {
+        EquityEngine engine("test_mode");
+        return engine.calculate_range_equity(req);
+    };
+
+    auto expect_identical = [](const std::unordered_map<std::string, EquityResult>& a,
+                               const std::unordered_map<std::string, EquityResult>& b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (const auto& pair : a) {
+            ASSERT_TRUE(b.count(pair.first)) << pair.first;
+            const EquityResult& x = pair.second;
+            const EquityResult& y = b.at(pair.first);
+            EXPECT_EQ(x.wins, y.wins) << pair.first;
+            EXPECT_EQ(x.ties, y.ties) << pair.first;
+            EXPECT_EQ(x.losses, y.losses) << pair.first;
+            EXPECT_EQ(x.total_simulations, y.total_simulations) << pair.first;
+            EXPECT_EQ(x.equity, y.equity) << pair.first;
+            for (int i = 0; i < 10; ++i) {
+                for (int j = 0; j < 10; ++j) {
+                    EXPECT_EQ(x.win_method_matrix[i][j], y.win_method_matrix[i][j]);
+                    EXPECT_EQ(x.loss_method_matrix[i][j], y.loss_method_matrix[i][j]);
+                }
+            }
+        }
+    };
+
+    auto baseline = run(request);
+    ASSERT_TRUE(baseline.count("AA"));
+    // A hand's overall counts only its own simulations
+    EXPECT_EQ(baseline["AA"].total_simulations, 4500u);
+    EXPECT_EQ(baseline["T9s"].total_simulations, 4500u);
+
+    request.optimizations = {"multithreading"};
+    for (int workers : {2, 3, 8}) {
+        request.num_workers = workers;
+        expect_identical(baseline, run(request));
+    }
+
+    // The SIMD batch path deals the same cards as the scalar path
+    request.optimizations = {"multithreading", "simd"};
+    request.num_workers = 3;
+    expect_identical(baseline, run(request));
+
+    // A different seed deals different cards
+    request.seed = 54321;
+    auto reseeded = run(request);
+    EXPECT_NE(baseline["AA"].wins, reseeded["AA"].wins);
+}
+
+TEST(EquityEngineTest, AlgorithmNamesSelectTheSameKernel) {
+    JobRequest request;
+    request.range_spec["KQs"] = {Card(13, 3), Card(12, 3)};
+    request.board = {};
+    request.num_opponents = 3;
+    request.num_simulations = 5000;
+    request.num_workers = 1;
+    request.seed = 99;
+
+    auto run = [&request](const std::string& algorithm) {
+        request.algorithm = algorithm;
+        EquityEngine engine("test_mode");
+        return engine.calculate_range_equity(request).at("KQs");
+    };
+
+    // Same seed, same cards: every spelling and every exact evaluator agrees
+    EquityResult reference = run("naive");
+    for (const char* algorithm : {"NAIVE", "omp", "OMP_EVAL", "ph_evaluator", "CACTUS_KEV"}) {
+        EquityResult result = run(algorithm);
+        EXPECT_EQ(result.wins, reference.wins) << algorithm;
+        EXPECT_EQ(result.ties, reference.ties) << algorithm;
+        EXPECT_EQ(result.losses, reference.losses) << algorithm;
+    }
+}
+
+TEST(EquityEngineTest, RejectsTooManyOpponents) {
+    EquityEngine engine("test_mode");
+
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.num_opponents = EquityEngine::kMaxOpponents + 1;
+    request.num_simulations = 100;
+    request.algorithm = "naive";
+    request.num_workers = 1;
+
+    EXPECT_THROW(engine.calculate_range_equity(request), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, SmallRunoutSpaceIsEnumeratedExactly) {
+    const std::vector<Card> hole = {Card(14, 3), Card(13, 3)};
+    const std::vector<Card> board = {Card(12, 3), Card(7, 0), Card(2, 1), Card(9, 3)};
+
+    // Brute force: every river card and every opponent hand
+    OMPEval evaluator;
+    uint32_t wins = 0, ties = 0, losses = 0;
+    std::vector<Card> live;
+    for (uint8_t id = 0; id < 52; ++id) {
+        const Card card = card_from_id(id);
+        if (std::find(hole.begin(), hole.end(), card) == hole.end() &&
+            std::find(board.begin(), board.end(), card) == board.end()) {
+            live.push_back(card);
+        }
+    }
+    for (size_t r = 0; r < live.size(); ++r) {
+        std::vector<Card> full_board = board;
+        full_board.push_back(live[r]);
+        const int32_t ours = evaluator.evaluate_hand(hole, full_board);
+        for (size_t a = 0; a < live.size(); ++a) {
+            for (size_t b = a + 1; b < live.size(); ++b) {
+                if (a == r || b == r) continue;
+                const int32_t theirs = evaluator.evaluate_hand({live[a], live[b]}, full_board);
+                if (ours > theirs) wins++;
+                else if (ours == theirs) ties++;
+                else losses++;
+            }
+        }
+    }
+
+    JobRequest request;
+    request.range_spec["AKs"] = hole;
+    request.board = board;
+    request.num_opponents = 1;
+    request.num_simulations = 100000;  // more than the 45540 deals, so enumerate
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+
+    for (int workers : {1, 4}) {
+        request.num_workers = workers;
+        EquityEngine engine("test_mode");
+        auto results = engine.calculate_range_equity(request);
+        ASSERT_TRUE(results.count("AKs"));
+        const EquityResult& result = results["AKs"];
+        EXPECT_EQ(result.total_simulations, 46u * 990u) << workers;
+        EXPECT_EQ(result.wins, wins) << workers;
+        EXPECT_EQ(result.ties, ties) << workers;
+        EXPECT_EQ(result.losses, losses) << workers;
+    }
+}
+
+TEST(EquityEngineTest, ExhaustiveOptionRejectsHugeDealSpaces) {
+    EquityEngine engine("test_mode");
+
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.num_opponents = 2;  // preflop: ~1.8e12 deals
+    request.num_simulations = 1000;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"exhaustive"};
+    request.num_workers = 1;
+
+    EXPECT_THROW(engine.calculate_range_equity(request), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, PrecisionTargetStopsEachHandWhenMet) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.range_spec["76s"] = {Card(7, 2), Card(6, 2)};
+    request.num_opponents = 1;
+    request.num_simulations = 2000000;  // 1M per hand, only a cap here
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.seed = 7;
+    request.target_std_error = 0.003;
+
+    std::unordered_map<std::string, EquityResult> reference;
+    for (int workers : {1, 4}) {
+        request.num_workers = workers;
+        EquityEngine engine("test_mode");
+        auto results = engine.calculate_range_equity(request);
+        for (const char* hand : {"AA", "76s"}) {
+            ASSERT_TRUE(results.count(hand));
+            const EquityResult& result = results[hand];
+            EXPECT_LE(result.std_error, 0.003) << hand;
+            EXPECT_LT(result.total_simulations, 100000u) << hand;
+            // Stopping only looks at whole rounds, so it does not depend on
+            // the number of threads
+            if (workers == 1) {
+                reference[hand] = result;
+            } else {
+                EXPECT_EQ(result.total_simulations, reference[hand].total_simulations) << hand;
+                EXPECT_EQ(result.wins, reference[hand].wins) << hand;
+            }
+        }
+    }
+    // The coin flip needs more simulations than the favourite
+    EXPECT_LT(reference["AA"].total_simulations, reference["76s"].total_simulations);
+}
+
+TEST(EquityEngineTest, PrecisionTargetIsCappedByNumSimulations) {
+    EquityEngine engine("test_mode");
+
+    JobRequest request;
+    request.range_spec["KQo"] = {Card(13, 0), Card(12, 1)};
+    request.num_opponents = 1;
+    request.num_simulations = 10000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 7;
+    request.target_std_error = 1e-5;
+
+    auto results = engine.calculate_range_equity(request);
+    ASSERT_TRUE(results.count("KQo"));
+    EXPECT_EQ(results["KQo"].total_simulations, 10000u);
+    EXPECT_GT(results["KQo"].std_error, 1e-5);
+}
+
+TEST(EquityEngineTest, NeymanScheduleEvensOutErrorsWithinTheBudget) {
+    JobRequest request;
+    // Quad aces on the flop barely vary; the other two hands do
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 2)};
+    request.range_spec["T9s"] = {Card(10, 0), Card(9, 0)};
+    request.range_spec["KQo"] = {Card(13, 2), Card(12, 3)};
+    request.board = {Card(14, 3), Card(14, 1), Card(2, 2)};
+    request.num_opponents = 1;
+    request.num_simulations = 300000;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.num_workers = 1;
+    request.seed = 11;
+
+    auto run = [&request](const std::string& schedule, int workers) {
+        JobRequest job = request;
+        job.schedule = schedule;
+        job.num_workers = workers;
+        EquityEngine engine("test_mode");
+        return engine.calculate_range_equity(job);
+    };
+    auto worst_error = [](std::unordered_map<std::string, EquityResult>& results) {
+        double worst = 0.0;
+        for (const char* hand : {"AA", "T9s", "KQo"}) worst = std::max(worst, results[hand].std_error);
+        return worst;
+    };
+
+    auto uniform = run("uniform", 1);
+    auto neyman = run("neyman", 1);
+
+    uint32_t spent = 0;
+    for (const char* hand : {"AA", "T9s", "KQo"}) {
+        ASSERT_TRUE(neyman.count(hand));
+        spent += neyman[hand].total_simulations;
+    }
+    EXPECT_LE(spent, 300000u);
+    EXPECT_GT(spent, 290000u);
+    EXPECT_LT(neyman["AA"].total_simulations, uniform["AA"].total_simulations);
+    EXPECT_LT(worst_error(neyman), worst_error(uniform));
+
+    // Re-balancing only looks at whole rounds
+    auto threaded = run("neyman", 4);
+    for (const char* hand : {"AA", "T9s", "KQo"}) {
+        EXPECT_EQ(threaded[hand].total_simulations, neyman[hand].total_simulations) << hand;
+        EXPECT_EQ(threaded[hand].wins, neyman[hand].wins) << hand;
+    }
+}
+
+TEST(EquityEngineTest, ProgressiveScheduleCoversEveryHandEarlyAndMatchesUniform) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.range_spec["T9s"] = {Card(10, 2), Card(9, 2)};
+    request.range_spec["72o"] = {Card(7, 0), Card(2, 3)};
+    request.num_opponents = 1;
+    request.num_simulations = 60000;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.seed = 5;
+
+    auto run = [&request](const std::string& schedule, int workers,
+                          std::vector<std::pair<double, std::unordered_map<std::string, double>>>*
+                              updates) {
+        JobRequest job = request;
+        job.schedule = schedule;
+        job.num_workers = workers;
+        EquityEngine engine("test_mode");
+        if (updates) {
+            engine.set_progress_callback(
+                [updates](double progress, const std::unordered_map<std::string, double>& results) {
+                    updates->emplace_back(progress, results);
+                });
+        }
+        return engine.calculate_range_equity(job);
+    };
+
+    auto uniform = run("uniform", 1, nullptr);
+    for (int workers : {1, 4}) {
+        std::vector<std::pair<double, std::unordered_map<std::string, double>>> updates;
+        auto progressive = run("progressive", workers, &updates);
+
+        // Same chunks, so the same final numbers
+        for (const char* hand : {"AA", "T9s", "72o"}) {
+            EXPECT_EQ(progressive[hand].total_simulations, 20000u) << hand;
+            EXPECT_EQ(progressive[hand].wins, uniform[hand].wins) << hand;
+            EXPECT_EQ(progressive[hand].ties, uniform[hand].ties) << hand;
+        }
+
+        // Some update well before the end already has every hand
+        ASSERT_FALSE(updates.empty());
+        bool early_full_grid = false;
+        for (const auto& [progress, results] : updates) {
+            if (progress < 0.5 && results.count("AA") && results.count("T9s") &&
+                results.count("72o")) {
+                early_full_grid = true;
+            }
+        }
+        EXPECT_TRUE(early_full_grid) << workers;
+    }
+}
+
+TEST(EquityEngineTest, BoardMajorSharesDealsAcrossTheRange) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.range_spec["AKs"] = {Card(14, 2), Card(13, 2)};
+    request.range_spec["T9s"] = {Card(10, 3), Card(9, 3)};
+    request.board = {Card(9, 0), Card(5, 1), Card(2, 2)};
+    request.num_opponents = 2;
+    request.num_simulations = 3 * 40000;
+    request.algorithm = "omp_eval";
+    request.seed = 21;
+
+    auto run = [&request](const std::vector<std::string>& optimizations, int workers) {
+        JobRequest job = request;
+        job.optimizations = optimizations;
+        job.num_workers = workers;
+        EquityEngine engine("test_mode");
+        return engine.calculate_range_equity(job);
+    };
+
+    auto per_hand = run({}, 1);
+    auto shared = run({"board_major"}, 1);
+    auto threaded = run({"board_major", "multithreading"}, 4);
+    for (const char* hand : {"AA", "AKs", "T9s"}) {
+        ASSERT_TRUE(shared.count(hand)) << hand;
+        // A hand only keeps the deals its own cards are not in
+        EXPECT_LT(shared[hand].total_simulations, 40000u) << hand;
+        EXPECT_GT(shared[hand].total_simulations, 25000u) << hand;
+        EXPECT_NEAR(shared[hand].equity, per_hand[hand].equity, 0.015) << hand;
+
+        EXPECT_EQ(threaded[hand].total_simulations, shared[hand].total_simulations) << hand;
+        EXPECT_EQ(threaded[hand].wins, shared[hand].wins) << hand;
+        EXPECT_EQ(threaded[hand].ties, shared[hand].ties) << hand;
+    }
+}
+
+TEST(EquityEngineTest, BoardCacheGivesTheSameResultsAsEvaluating) {
+    struct Case {
+        std::vector<Card> board;
+        int num_opponents;
+        int num_simulations;
+        std::vector<std::string> optimizations;
+    };
+    const std::vector<Case> cases = {
+        // Flop: the range's showdowns outnumber the 1176 runouts' vectors
+        {{Card(9, 0), Card(5, 1), Card(2, 2)}, 2, 3 * 200000, {"simd"}},
+        {{Card(9, 0), Card(5, 1), Card(2, 2), Card(13, 3)}, 3, 3 * 20000, {"board_major"}},
+        {{Card(9, 0), Card(5, 1), Card(2, 2), Card(13, 3), Card(13, 0)}, 3, 3 * 5000, {}},
+        // River against one opponent is enumerated
+        {{Card(9, 0), Card(5, 1), Card(2, 2), Card(13, 3), Card(13, 0)}, 1, 3 * 5000, {}},
+    };
+
+    for (const Case& c : cases) {
+        JobRequest request;
+        request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+        request.range_spec["AKs"] = {Card(14, 2), Card(13, 2)};
+        request.range_spec["T9s"] = {Card(10, 3), Card(9, 3)};
+        request.board = c.board;
+        request.num_opponents = c.num_opponents;
+        request.num_simulations = c.num_simulations;
+        request.algorithm = "omp_eval";
+        request.num_workers = 1;
+        request.seed = 5;
+
+        request.optimizations = c.optimizations;
+        auto evaluated = EquityEngine("test_mode").calculate_range_equity(request);
+        request.optimizations.push_back("board_cache");
+        auto lookups = [] {
+            const BoardRankCache::Stats stats = BoardRankCache::instance().stats();
+            return stats.hits + stats.misses;
+        };
+        const uint64_t before = lookups();
+        auto looked_up = EquityEngine("test_mode").calculate_range_equity(request);
+        EXPECT_GT(lookups(), before) << c.board.size();
+
+        // A second job on the board fills nothing
+        const uint64_t refilled = BoardRankCache::instance().stats().misses;
+        auto repeated = EquityEngine("test_mode").calculate_range_equity(request);
+        EXPECT_EQ(BoardRankCache::instance().stats().misses, refilled);
+
+        for (const char* hand : {"AA", "AKs", "T9s"}) {
+            EXPECT_EQ(looked_up[hand].total_simulations, evaluated[hand].total_simulations) << hand;
+            EXPECT_EQ(looked_up[hand].wins, evaluated[hand].wins) << hand;
+            EXPECT_EQ(looked_up[hand].ties, evaluated[hand].ties) << hand;
+            EXPECT_EQ(repeated[hand].wins, evaluated[hand].wins) << hand;
+        }
+    }
+}
+
+TEST(EquityEngineTest, RiverGridIsExactForEveryClass) {
+    JobRequest request;
+    request.range_spec["AKs"] = {Card(14, 3), Card(13, 3)};
+    request.range_spec["my_pair"] = {Card(9, 0), Card(9, 1)};
+    request.board = {Card(2, 0), Card(7, 1), Card(9, 2), Card(11, 3), Card(13, 0)};
+    request.num_opponents = 1;
+    request.num_simulations = 2 * 1000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+
+    // Heads-up on the river is enumerated: the same 990 deals per hand
+    JobRequest grid = request;
+    grid.mode = "cpp_river_grid";
+    auto exact = EquityEngine("test_mode").calculate_range_equity(request);
+    auto solved = EquityEngine("test_mode").calculate_range_equity(grid);
+    for (const char* hand : {"AKs", "my_pair"}) {
+        ASSERT_TRUE(solved.count(hand)) << hand;
+        EXPECT_EQ(solved[hand].total_simulations, 990u) << hand;
+        EXPECT_EQ(solved[hand].wins, exact[hand].wins) << hand;
+        EXPECT_EQ(solved[hand].ties, exact[hand].ties) << hand;
+        EXPECT_EQ(solved[hand].losses, exact[hand].losses) << hand;
+        EXPECT_EQ(solved[hand].std_error, 0.0) << hand;
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                EXPECT_EQ(solved[hand].win_method_matrix[i][j], exact[hand].win_method_matrix[i][j]);
+                EXPECT_EQ(solved[hand].loss_method_matrix[i][j], exact[hand].loss_method_matrix[i][j]);
+            }
+        }
+    }
+
+    // Every class of the grid, over the combos the board leaves: with the
+    // king of clubs out, AKo keeps 9 of its 12. "AKs" is the spec hand's.
+    EXPECT_EQ(solved.size(), 169u + 1u);  // the grid plus "my_pair"
+    EXPECT_EQ(solved["AKo"].total_simulations, 9u * 990u);
+    EXPECT_EQ(solved["AA"].total_simulations, 6u * 990u);
+    EXPECT_GT(solved["AA"].equity, solved["43o"].equity);
+
+    grid.board.pop_back();
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(grid), std::invalid_argument);
+    grid.board = request.board;
+    grid.num_opponents = 2;
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(grid), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, RiverGridSolvesAgainstAnOpponentRange) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    // 2c 7d 9h Js Ks
+    request.board = {Card(2, 0), Card(7, 1), Card(9, 2), Card(11, 3), Card(13, 0)};
+    request.num_opponents = 1;
+    request.num_simulations = 1000;
+    request.algorithm = "omp_eval";
+    request.mode = "cpp_river_grid";
+    request.num_workers = 1;
+
+    // 72o beats AA and 43o loses to it; the other two combos are blocked
+    request.opponent_ranges = {{
+        {{Card(7, 0), Card(2, 1)}, 1.0},
+        {{Card(4, 0), Card(3, 1)}, 3.0},
+        {{Card(14, 2), Card(14, 0)}, 100.0},  // holds the hero's ace
+        {{Card(13, 0), Card(13, 1)}, 100.0},  // holds a board king
+    }};
+    auto results = EquityEngine("test_mode").calculate_range_equity(request);
+    ASSERT_TRUE(results.count("AA"));
+    EXPECT_EQ(results["AA"].wins, 3u);
+    EXPECT_EQ(results["AA"].losses, 1u);
+    EXPECT_EQ(results["AA"].total_simulations, 4u);
+    EXPECT_DOUBLE_EQ(results["AA"].equity, 0.75);
+
+    // Fractional weights are scaled to integers in proportion
+    request.opponent_ranges[0][0].weight = 0.25;
+    request.opponent_ranges[0][1].weight = 0.75;
+    results = EquityEngine("test_mode").calculate_range_equity(request);
+    EXPECT_NEAR(results["AA"].equity, 0.75, 1e-4);
+
+    // Only one seat, and a spec hand needs an opponent combo left open
+    request.num_opponents = 2;
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+    request.num_opponents = 1;
+    request.opponent_ranges = {{{{Card(14, 0), Card(14, 2)}, 1.0}}};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, OpponentRangesDrawCombosByWeight) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    // 2c 7d 9h Js Ks
+    request.board = {Card(2, 0), Card(7, 1), Card(9, 2), Card(11, 3), Card(13, 0)};
+    request.num_opponents = 1;
+    request.num_simulations = 20000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 31;
+
+    // 72o makes two pair and beats AA; 43o is king high and loses to it.
+    // The 4c and 3d collide with nothing, the other combos with AA or the
+    // board, so only the first two are ever dealt.
+    request.opponent_ranges = {{
+        {{Card(7, 0), Card(2, 1)}, 1.0},
+        {{Card(4, 0), Card(3, 1)}, 3.0},
+        {{Card(14, 2), Card(14, 0)}, 100.0},  // holds the hero's ace
+        {{Card(13, 0), Card(13, 1)}, 100.0},  // holds a board king
+    }};
+    auto results = EquityEngine("test_mode").calculate_range_equity(request);
+    ASSERT_TRUE(results.count("AA"));
+    EXPECT_EQ(results["AA"].total_simulations, 20000u);
+    EXPECT_NEAR(results["AA"].equity, 0.75, 0.015);
+
+    // Preflop KK against a range of only AA is about 18%, far from its 82%
+    // against a random hand
+    JobRequest kings;
+    kings.range_spec["KK"] = {Card(13, 0), Card(13, 1)};
+    kings.num_opponents = 1;
+    kings.num_simulations = 20000;
+    kings.algorithm = "omp_eval";
+    kings.num_workers = 1;
+    kings.seed = 32;
+    kings.opponent_ranges.emplace_back();
+    for (uint8_t a = 0; a < 4; ++a) {
+        for (uint8_t b = a + 1; b < 4; ++b) {
+            kings.opponent_ranges[0].push_back({{Card(14, a), Card(14, b)}, 1.0});
+        }
+    }
+    results = EquityEngine("test_mode").calculate_range_equity(kings);
+    EXPECT_NEAR(results["KK"].equity, 0.18, 0.02);
+}
+
+TEST(EquityEngineTest, OpponentRangesMatchRandomHandsWhenUniform) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.range_spec["T9s"] = {Card(10, 2), Card(9, 2)};
+    request.num_opponents = 2;
+    request.num_simulations = 60000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 33;
+
+    // Every combo at weight 1 is a random hand, seat after seat
+    JobRequest weighted = request;
+    weighted.opponent_ranges.emplace_back();
+    for (uint8_t a = 0; a < 52; ++a) {
+        for (uint8_t b = a + 1; b < 52; ++b) {
+            weighted.opponent_ranges[0].push_back({{card_from_id(a), card_from_id(b)}, 1.0});
+        }
+    }
+    auto random = EquityEngine("test_mode").calculate_range_equity(request);
+    auto ranged = EquityEngine("test_mode").calculate_range_equity(weighted);
+    for (const char* hand : {"AA", "T9s"}) {
+        EXPECT_NEAR(ranged[hand].equity, random[hand].equity, 0.015) << hand;
+    }
+
+    // Seeded weighted jobs do not depend on the worker count either
+    weighted.optimizations = {"multithreading"};
+    weighted.num_workers = 4;
+    auto threaded = EquityEngine("test_mode").calculate_range_equity(weighted);
+    for (const char* hand : {"AA", "T9s"}) {
+        EXPECT_EQ(threaded[hand].wins, ranged[hand].wins) << hand;
+        EXPECT_EQ(threaded[hand].ties, ranged[hand].ties) << hand;
+    }
+}
+
+TEST(EquityEngineTest, RejectsInvalidOpponentRanges) {
+    JobRequest request;
+    request.range_spec["AA"] = {Card(14, 0), Card(14, 1)};
+    request.num_opponents = 3;
+    request.num_simulations = 1000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    const WeightedRange pairs = {
+        {{Card(13, 0), Card(13, 1)}, 1.0},
+        {{Card(12, 0), Card(12, 1)}, 1.0},
+        {{Card(11, 0), Card(11, 1)}, 1.0},
+    };
+
+    // One range or one per seat
+    request.opponent_ranges = {pairs, pairs};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+    request.opponent_ranges = {pairs};
+    EXPECT_NO_THROW(EquityEngine("test_mode").calculate_range_equity(request));
+
+    // Weights and cards
+    request.opponent_ranges = {{{{Card(13, 0), Card(13, 1)}, -1.0}}};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+    request.opponent_ranges = {{{{Card(13, 0), Card(13, 0)}, 1.0}}};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+
+    // Nothing left around the hero's hand, or for the last seat once the
+    // others hold the range's only combo
+    request.opponent_ranges = {{{{Card(14, 0), Card(14, 2)}, 1.0}}};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+    request.opponent_ranges = {{pairs[0]}};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+
+    // The enumerator only deals random hands
+    request.opponent_ranges = {pairs};
+    request.optimizations = {"exhaustive"};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(request), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, RangeNotationRunsEveryUnblockedCombo) {
+    JobRequest request;
+    request.range = parse_range_notation("AA, KQs:0.5");
+    request.range_spec["T9s"] = {Card(10, 2), Card(9, 2)};
+    request.board = {Card(14, 0), Card(7, 1), Card(2, 2)};
+    request.num_opponents = 1;
+    request.num_simulations = 8 * 2000;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 34;
+
+    // The board's ace leaves 3 of the 6 aces; KQs keeps all 4. Each is a
+    // hand of its own, with "T9s" the eighth.
+    auto results = EquityEngine("test_mode").calculate_range_equity(request);
+    for (const char* hand : {"AsAc", "AsAd", "AcAd", "KhQh", "KdQd", "KcQc", "KsQs", "T9s"}) {
+        ASSERT_TRUE(results.count(hand)) << hand;
+        EXPECT_EQ(results[hand].total_simulations, 2000u) << hand;
+    }
+    EXPECT_FALSE(results.count("AhAd"));
+    EXPECT_GT(results["AsAc"].equity, results["KhQh"].equity);
+
+    // Opponent ranges compile the same way
+    request.range.reset();
+    request.opponent_ranges = {weighted_range(parse_range_notation("AA"))};
+    EXPECT_EQ(request.opponent_ranges[0].size(), 6u);
+    results = EquityEngine("test_mode").calculate_range_equity(request);
+    EXPECT_LT(results["T9s"].equity, 0.1);
+}
+
+TEST(EquityEngineTest, FullRangeJobRunsEveryCombo) {
+    // The Ah Kd 7c flop leaves 1176 combos, and no suit relabelling other
+    // than the identity fixes it, so each one is a hand of its own
+    JobRequest request;
+    request.range = parse_range_notation(
+        "22+, A2+, K2+, Q2+, J2+, T2+, 92+, 82+, 72+, 62+, 52+, 42+, 32");
+    request.board = {Card(14, 0), Card(13, 1), Card(7, 2)};
+    request.num_opponents = 1;
+    request.num_simulations = 1176 * 64;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.num_workers = 4;
+    request.seed = 37;
+    auto results = EquityEngine("test_mode").calculate_range_equity(request);
+
+    // Combo names have four characters, opponent classes at most three
+    size_t hands = 0;
+    uint64_t hand_simulations = 0;
+    uint64_t class_simulations = 0;
+    for (const auto& [name, result] : results) {
+        if (name.size() == 4) {
+            hands++;
+            EXPECT_EQ(result.total_simulations, 64u) << name;
+            hand_simulations += result.total_simulations;
+        } else {
+            class_simulations += result.total_simulations;
+        }
+    }
+    EXPECT_EQ(hands, 1176u);
+    EXPECT_EQ(class_simulations, hand_simulations);
+    EXPECT_GT(results["AsAc"].equity, results["3s2s"].equity);
+}
+
+TEST(EquityEngineTest, SuitIsomorphicHandsShareOneSimulation) {
+    JobRequest request;
+    request.range = parse_range_notation("AKs, 22");
+    request.num_opponents = 1;
+    request.num_simulations = 10 * 8192;
+    request.algorithm = "omp_eval";
+    request.num_workers = 1;
+    request.seed = 36;
+
+    // Preflop every AKs is one hand's simulation, shared by all four
+    auto results = EquityEngine("test_mode").calculate_range_equity(request);
+    for (const char* hand : {"AhKh", "AdKd", "AcKc", "AsKs"}) {
+        ASSERT_TRUE(results.count(hand)) << hand;
+        EXPECT_EQ(results[hand].total_simulations, 8192u) << hand;
+        EXPECT_EQ(results[hand].wins, results["AhKh"].wins) << hand;
+    }
+    EXPECT_EQ(results["2d2h"].total_simulations, 8192u);
+    EXPECT_NEAR(results["AsKs"].equity, 0.67, 0.02);
+    EXPECT_NEAR(results["2s2c"].equity, 0.50, 0.02);
+
+    // On Ah Ad 2c only hearts and diamonds trade places
+    request.range.reset();
+    request.range_spec["KhQh"] = {Card(13, 0), Card(12, 0)};
+    request.range_spec["KdQd"] = {Card(13, 1), Card(12, 1)};
+    request.range_spec["KsQs"] = {Card(13, 3), Card(12, 3)};
+    request.board = {Card(14, 0), Card(14, 1), Card(2, 2)};
+    request.num_simulations = 3 * 2048;
+    results = EquityEngine("test_mode").calculate_range_equity(request);
+    EXPECT_EQ(results["KhQh"].total_simulations, 2048u);
+    EXPECT_EQ(results["KdQd"].wins, results["KhQh"].wins);
+    EXPECT_EQ(results["KsQs"].total_simulations, 2048u);
+
+    // An enumerated group runs its deals once and counts them per hand
+    request.range_spec.erase("KsQs");
+    request.board = {Card(14, 0), Card(14, 1), Card(7, 2), Card(5, 3), Card(2, 2)};
+    request.num_simulations = 2 * 1000;
+    const auto both = EquityEngine("test_mode").calculate_range_equity(request);
+    request.range_spec.erase("KdQd");
+    request.num_simulations = 1000;
+    const auto alone = EquityEngine("test_mode").calculate_range_equity(request);
+    EXPECT_EQ(both.at("KdQd").total_simulations, 990u);
+    EXPECT_EQ(both.at("KdQd").wins, alone.at("KhQh").wins);
+    EXPECT_EQ(both.at("KdQd").ties, alone.at("KhQh").ties);
+    for (const auto& [name, result] : alone) {
+        if (name == "KhQh") continue;
+        EXPECT_EQ(both.at(name).total_simulations, 2 * result.total_simulations) << name;
+    }
+}
+
+TEST(EquityEngineTest, PreflopMatrixJobSolvesEveryClassPair) {
+    JobRequest request;
+    request.num_opponents = 1;
+    request.num_simulations = 3000;  // boards
+    request.algorithm = "omp_eval";
+    request.mode = "cpp_preflop_matrix";
+    request.num_workers = 1;
+    request.seed = 35;
+
+    EquityEngine engine("test_mode");
+    auto results = engine.calculate_range_equity(request);
+    const auto matrix = engine.preflop_matrix();
+    ASSERT_TRUE(matrix);
+    EXPECT_EQ(matrix->boards, 3000u);
+
+    auto class_of = [](const char* name) {
+        for (int c = 0; c < kNumHandClasses; ++c) {
+            if (hand_class_name(c) == name) return c;
+        }
+        return -1;
+    };
+    const int aces = class_of("AA");
+    const int kings = class_of("KK");
+    const int ak = class_of("AKs");
+    const int deuces = class_of("22");
+    EXPECT_NEAR(matrix->equity(aces, kings), 0.82, 0.03);
+    EXPECT_NEAR(matrix->equity(ak, deuces), 0.50, 0.03);
+    for (int a = 0; a < kNumHandClasses; a += 7) {
+        for (int b = 0; b < kNumHandClasses; b += 5) {
+            EXPECT_NEAR(matrix->equity(a, b) + matrix->equity(b, a), 1.0, 1e-5);
+        }
+        EXPECT_NEAR(matrix->equity(a, a), 0.5, 1e-5);
+    }
+
+    // Results hold each class against a random hand
+    EXPECT_EQ(results.size(), static_cast<size_t>(kNumHandClasses));
+    EXPECT_NEAR(results["AA"].equity, 0.852, 0.01);
+    EXPECT_NEAR(results["72o"].equity, 0.346, 0.01);
+
+    // Seeded: the same matrix on the pool
+    JobRequest threaded = request;
+    threaded.optimizations = {"multithreading"};
+    threaded.num_workers = 4;
+    const PreflopMatrix pooled = EquityEngine("test_mode").calculate_preflop_matrix(threaded);
+    EXPECT_EQ(pooled.win, matrix->win);
+    EXPECT_EQ(pooled.tie, matrix->tie);
+
+    JobRequest flop = request;
+    flop.board = {Card(14, 0), Card(7, 1), Card(2, 2)};
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(flop), std::invalid_argument);
+    JobRequest multiway = request;
+    multiway.num_opponents = 2;
+    EXPECT_THROW(EquityEngine("test_mode").calculate_range_equity(multiway), std::invalid_argument);
+}
+
+TEST(EquityEngineTest, ReporterPathMatchesDirectRun) {
+    JobRequest request;
+    request.range_spec["QQ"] = {Card(12, 0), Card(12, 1)};
+    request.range_spec["A5s"] = {Card(14, 3), Card(5, 3)};
+    request.board = {};
+    request.num_opponents = 2;
+    request.num_simulations = 60000;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.num_workers = 4;
+    request.seed = 2024;
+
+    EquityEngine direct("test_mode");
+    auto expected = direct.calculate_range_equity(request);
+
+    // With a job id every worker gets a thread and the caller reports
+    // progress into shared memory while they run
+    const std::string job_id = "engine_test_" + std::to_string(::getpid());
+    EquityEngine reported("test_mode", job_id);
+    auto actual = reported.calculate_range_equity(request);
+    shm_unlink(("/poker_telemetry_" + job_id).c_str());
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (const auto& pair : expected) {
+        ASSERT_TRUE(actual.count(pair.first)) << pair.first;
+        EXPECT_EQ(actual[pair.first].wins, pair.second.wins) << pair.first;
+        EXPECT_EQ(actual[pair.first].ties, pair.second.ties) << pair.first;
+        EXPECT_EQ(actual[pair.first].total_simulations, pair.second.total_simulations)
+            << pair.first;
+    }
+}
+
+TEST(EquityEngineTest, WorkerScalingBenchmark) {
+    JobRequest request;
+    request.range_spec["AKs"] = {Card(14, 0), Card(13, 0)};
+    request.board = {};
+    request.num_opponents = 2;
+    request.algorithm = "omp_eval";
+    request.optimizations = {"multithreading"};
+    request.seed = 1;
+
+    const int max_workers =
+        std::min(32, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    double single = 0.0;
+    for (int workers = 1; workers <= max_workers; workers *= 2) {
+        request.num_workers = workers;
+        request.num_simulations = 200000 * workers;
+        EquityEngine engine("test_mode");
+        auto start = std::chrono::steady_clock::now();
+        auto results = engine.calculate_range_equity(request);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        ASSERT_EQ(results["AKs"].total_simulations, static_cast<uint32_t>(request.num_simulations));
+
+        const double rate = request.num_simulations / elapsed.count();
+        if (workers == 1) single = rate;
+        std::cout << "[ BENCHMARK ] " << workers << " workers: " << rate / 1e6
+                  << " M sims/s (" << rate / single << "x)" << std::endl;
+    }
+}
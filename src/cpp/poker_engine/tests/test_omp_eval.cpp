@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../evaluators/omp_eval.h"
+#include "../evaluators/hand_types.h"
+#include "../core/deck.h"
 
 using namespace poker_engine;
 
@@ -15,3 +17,86 @@ TEST_F(OMPEvalTest, EvaluatesHand) {
     int32_t score = evaluator.evaluate_hand(hole, board);
     EXPECT_GT(score, 0);
 }
+
+// Every kernel the host can run, from scalar up to the detected level
+static std::vector<SimdLevel> SupportedLevels() {
+    std::vector<SimdLevel> levels;
+    for (int l = 0; l <= static_cast<int>(SIMDHelper::DetectLevel()); ++l) {
+        levels.push_back(static_cast<SimdLevel>(l));
+    }
+    return levels;
+}
+
+TEST_F(OMPEvalTest, BatchMatchesScalar) {
+    for (SimdLevel level : SupportedLevels()) {
+        OMPEval batch_evaluator(level);
+        const int lanes = batch_evaluator.batch_size();
+        Deck deck(42);
+        for (int iter = 0; iter < 2000; ++iter) {
+            HandBatch batch;
+            int32_t expected[SIMDConfig::kMaxBatchSize];
+            for (int b = 0; b < lanes; ++b) {
+                deck.reset();
+                std::vector<Card> hole = deck.sample(2);
+                std::vector<Card> board = deck.sample(5);
+                for (int i = 0; i < 2; ++i) {
+                    batch.ranks[i][b] = hole[i].rank;
+                    batch.suits[i][b] = hole[i].suit;
+                }
+                for (int i = 0; i < 5; ++i) {
+                    batch.ranks[i + 2][b] = board[i].rank;
+                    batch.suits[i + 2][b] = board[i].suit;
+                }
+                expected[b] = evaluator.evaluate_hand(hole, board);
+            }
+
+            int32_t results[SIMDConfig::kMaxBatchSize];
+            batch_evaluator.evaluate_batch(batch, results);
+            for (int b = 0; b < lanes; ++b) {
+                ASSERT_EQ(results[b], expected[b])
+                    << SIMDHelper::LevelName(level) << " lane " << b << " of batch " << iter;
+            }
+        }
+    }
+}
+
+TEST_F(OMPEvalTest, BatchHandlesEveryCategory) {
+    // One hand per lane: royal flush, steel wheel, quads, full house from two
+    // trips, flush with six suited cards, wheel, two pair with three pairs,
+    // high card. Repeated to fill 16 lanes.
+    const Card hands[8][7] = {
+        {Card(14, 0), Card(13, 0), Card(12, 0), Card(11, 0), Card(10, 0), Card(2, 1), Card(3, 2)},
+        {Card(14, 1), Card(2, 1), Card(3, 1), Card(4, 1), Card(5, 1), Card(9, 0), Card(13, 2)},
+        {Card(7, 0), Card(7, 1), Card(7, 2), Card(7, 3), Card(14, 0), Card(2, 1), Card(2, 2)},
+        {Card(9, 0), Card(9, 1), Card(9, 2), Card(4, 3), Card(4, 0), Card(4, 1), Card(13, 2)},
+        {Card(2, 2), Card(5, 2), Card(7, 2), Card(9, 2), Card(11, 2), Card(13, 2), Card(14, 0)},
+        {Card(14, 0), Card(2, 1), Card(3, 2), Card(4, 3), Card(5, 0), Card(9, 1), Card(9, 2)},
+        {Card(12, 0), Card(12, 1), Card(8, 2), Card(8, 3), Card(6, 0), Card(6, 1), Card(3, 2)},
+        {Card(2, 0), Card(4, 1), Card(6, 2), Card(8, 3), Card(10, 0), Card(12, 1), Card(13, 2)},
+    };
+
+    HandBatch batch;
+    int32_t expected[SIMDConfig::kMaxBatchSize];
+    for (int b = 0; b < SIMDConfig::kMaxBatchSize; ++b) {
+        const Card* hand = hands[b % 8];
+        for (int i = 0; i < 7; ++i) {
+            batch.ranks[i][b] = hand[i].rank;
+            batch.suits[i][b] = hand[i].suit;
+        }
+        std::vector<Card> hole(hand, hand + 2);
+        std::vector<Card> board(hand + 2, hand + 7);
+        expected[b] = evaluator.evaluate_hand(hole, board);
+    }
+
+    for (SimdLevel level : SupportedLevels()) {
+        OMPEval batch_evaluator(level);
+        int32_t results[SIMDConfig::kMaxBatchSize];
+        batch_evaluator.evaluate_batch(batch, results);
+        for (int b = 0; b < batch_evaluator.batch_size(); ++b) {
+            EXPECT_EQ(results[b], expected[b]) << SIMDHelper::LevelName(level) << " lane " << b;
+        }
+        EXPECT_EQ(get_hand_type(results[0]), HandType::ROYAL_FLUSH);
+        EXPECT_EQ(get_hand_type(results[1]), HandType::STRAIGHT_FLUSH);
+        EXPECT_EQ(get_hand_type(results[6]), HandType::TWO_PAIR);
+    }
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstring>
+#include <map>
+#include <utility>
+#include "../engine/preflop_matrix.h"
+
+using namespace poker_engine;
+
+namespace {
+
+int class_of(const char* name) {
+    for (int hand_class = 0; hand_class < kNumHandClasses; ++hand_class) {
+        if (hand_class_name(hand_class) == name) return hand_class;
+    }
+    return -1;
+}
+
+}  // namespace
+
+TEST(PreflopMatrixTest, MatchupsCoverEveryCellOnceUpToSuits) {
+    const MatrixMatchups& matchups = matrix_matchups();
+
+    // Every cell on or above the diagonal, weighted by the villain combos
+    // that one hero combo leaves
+    std::map<std::pair<int, int>, uint32_t> weights;
+    std::map<std::pair<int, int>, int> representatives;
+    for (size_t i = 0; i < matchups.size(); ++i) {
+        ASSERT_LE(matchups.cell_hero[i], matchups.cell_villain[i]);
+        EXPECT_EQ(std::popcount(matchups.mask[i]), 4);
+        const auto cell = std::make_pair<int, int>(matchups.cell_hero[i], matchups.cell_villain[i]);
+        weights[cell] += matchups.weight[i];
+        representatives[cell]++;
+    }
+    EXPECT_EQ(weights.size(), static_cast<size_t>(kNumHandClasses * (kNumHandClasses + 1) / 2));
+
+    const int aces = class_of("AA");
+    const int kings = class_of("KK");
+    const int ak_suited = class_of("AKs");
+    const int ak_offsuit = class_of("AKo");
+    EXPECT_EQ(weights[std::make_pair(aces, aces)], 1u);   // the two aces left
+    EXPECT_EQ(weights[std::make_pair(aces, kings)], 6u);
+    EXPECT_EQ(weights[std::make_pair(aces, ak_suited)], 2u);  // AK suited in the other two suits
+    EXPECT_EQ(weights[std::make_pair(aces, ak_offsuit)], 6u);  // 2 aces x 4 kings, minus 2 suited
+    // KK against AA: villain kings that share both, one or neither suit
+    EXPECT_EQ(representatives[std::make_pair(aces, kings)], 3);
+
+    // About 47k matchups to play instead of the 812k unordered combo pairs
+    EXPECT_LT(matchups.size(), 50000u);
+}
+
+TEST(PreflopMatrixTest, BinaryLayout) {
+    PreflopMatrix matrix;
+    matrix.boards = 1000;
+    matrix.win[1] = 0.25f;
+    matrix.tie[2] = 0.5f;
+
+    const std::string bytes = matrix.to_binary();
+    constexpr size_t kCells = PreflopMatrix::kSize * PreflopMatrix::kSize;
+    ASSERT_EQ(bytes.size(), 4u + 4u + 8u + 2u * kCells * 4u);
+    EXPECT_EQ(bytes.substr(0, 4), "PFM1");
+
+    uint32_t size;
+    uint64_t boards;
+    float win;
+    float tie;
+    std::memcpy(&size, bytes.data() + 4, 4);
+    std::memcpy(&boards, bytes.data() + 8, 8);
+    std::memcpy(&win, bytes.data() + 16 + 1 * 4, 4);
+    std::memcpy(&tie, bytes.data() + 16 + kCells * 4 + 2 * 4, 4);
+    EXPECT_EQ(size, 169u);
+    EXPECT_EQ(boards, 1000u);
+    EXPECT_EQ(win, 0.25f);
+    EXPECT_EQ(tie, 0.5f);
+}
+
+TEST(PreflopMatrixTest, AssemblyMirrorsAndWeightsCells) {
+    const MatrixMatchups& matchups = matrix_matchups();
+    MatchupCounts counts(matchups.size());
+    // Hero wins every board in every matchup it is the lower class of
+    for (size_t i = 0; i < matchups.size(); ++i) {
+        counts.total[i] = 10;
+        counts.wins[i] = matchups.cell_hero[i] == matchups.cell_villain[i] ? 4 : 10;
+        counts.ties[i] = matchups.cell_hero[i] == matchups.cell_villain[i] ? 2 : 0;
+    }
+    const PreflopMatrix matrix = assemble_preflop_matrix(matchups, counts, 10);
+    const int aces = class_of("AA");
+    const int kings = class_of("KK");
+    EXPECT_FLOAT_EQ(matrix.win_rate(aces, kings), 1.0f);
+    EXPECT_FLOAT_EQ(matrix.win_rate(kings, aces), 0.0f);
+    EXPECT_FLOAT_EQ(matrix.tie_rate(kings, aces), 0.0f);
+    // The diagonal: 2 ties in 10, the rest split evenly
+    EXPECT_FLOAT_EQ(matrix.win_rate(kings, kings), 0.4f);
+    EXPECT_FLOAT_EQ(matrix.tie_rate(kings, kings), 0.2f);
+    EXPECT_FLOAT_EQ(matrix.equity(kings, kings), 0.5f);
+}
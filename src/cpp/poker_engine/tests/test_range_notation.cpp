@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "../core/range_notation.h"
+
+namespace {
+
+int combo_of(const std::string& name) {
+    const ComboRange range = parse_range_notation(name);
+    int result = -1;
+    range.combos.for_each([&result](int combo) { result = combo; });
+    return result;
+}
+
+}  // namespace
+
+TEST(RangeNotationTest, ExpandsClassesPlusesAndSpans) {
+    EXPECT_EQ(parse_range_notation("AA").combos.count(), 6);
+    EXPECT_EQ(parse_range_notation("AKs").combos.count(), 4);
+    EXPECT_EQ(parse_range_notation("AKo").combos.count(), 12);
+    EXPECT_EQ(parse_range_notation("AK").combos.count(), 16);
+    EXPECT_EQ(parse_range_notation("TT+").combos.count(), 5 * 6);
+    EXPECT_EQ(parse_range_notation("22+").combos.count(), 13 * 6);
+    EXPECT_EQ(parse_range_notation("ATs+").combos.count(), 4 * 4);    // ATs-AKs
+    EXPECT_EQ(parse_range_notation("K9o+").combos.count(), 4 * 12);   // K9o-KQo
+    EXPECT_EQ(parse_range_notation("A2s-A5s").combos.count(), 4 * 4);
+    EXPECT_EQ(parse_range_notation("55-22").combos.count(), 4 * 6);
+    EXPECT_EQ(parse_range_notation("AhKd").combos.count(), 1);
+
+    // Order and case do not matter; overlaps count once
+    EXPECT_EQ(parse_range_notation("KA").combos, parse_range_notation("AK").combos);
+    EXPECT_EQ(parse_range_notation("tt+, aks").combos, parse_range_notation("TT+,AKs").combos);
+    EXPECT_EQ(parse_range_notation("QQ+, KK").combos.count(), 3 * 6);
+    EXPECT_EQ(parse_range_notation("AK, AKs").combos, parse_range_notation("AK").combos);
+    EXPECT_TRUE(parse_range_notation("").combos.empty());
+
+    // Every hand: the whole grid
+    EXPECT_EQ(parse_range_notation("22+, A2+, K2+, Q2+, J2+, T2+, 92+, 82+, 72+, 62+, 52+, 42+, 32")
+                  .combos.count(),
+              kNumHandCombos);
+}
+
+TEST(RangeNotationTest, WeightsApplyPerItemAndLaterItemsWin) {
+    const ComboRange range = parse_range_notation("TT+, AKs, KQo:0.5, AA:0.25, JJ:0");
+    EXPECT_EQ(range.combos.count(), 4 * 6 + 4 + 12);  // JJ removed
+    const int kq = combo_of("KhQd");
+    const int aces = combo_of("AsAh");
+    const int tens = combo_of("ThTs");
+    EXPECT_TRUE(range.combos.contains(kq));
+    EXPECT_DOUBLE_EQ(range.weights[kq], 0.5);
+    EXPECT_DOUBLE_EQ(range.weights[aces], 0.25);
+    EXPECT_DOUBLE_EQ(range.weights[tens], 1.0);
+    EXPECT_FALSE(range.combos.contains(combo_of("JhJd")));
+}
+
+TEST(RangeNotationTest, SetOperationsAndBlockers) {
+    const ComboSet pairs = parse_range_notation("22+").combos;
+    const ComboSet aces = parse_range_notation("AA, AK, AQ").combos;
+    EXPECT_EQ((pairs & aces).count(), 6);
+    EXPECT_EQ((pairs | aces).count(), 13 * 6 + 32);
+    EXPECT_EQ((pairs - aces).count(), 12 * 6);
+
+    // One card blocks the 51 combos holding it; a three-card board 3 * 51
+    // minus the 3 combos of two board cards
+    const uint64_t ace = uint64_t{1} << card_id(Card(14, 0));
+    EXPECT_EQ(ComboSet::holding(ace).count(), 51);
+    const uint64_t flop = ace | (uint64_t{1} << card_id(Card(7, 1))) |
+                          (uint64_t{1} << card_id(Card(2, 2)));
+    EXPECT_EQ(ComboSet::holding(flop).count(), 3 * 51 - 3);
+
+    ComboRange range = parse_range_notation("AA, 77");
+    range.remove_blocked(flop);
+    EXPECT_EQ(range.combos.count(), 3 + 3);
+}
+
+TEST(RangeNotationTest, NamesCombosHighCardFirst) {
+    EXPECT_EQ(combo_name(combo_of("KdAh")), "AhKd");
+    EXPECT_EQ(combo_name(combo_of("2c7s")), "7s2c");
+    for (int combo = 0; combo < kNumHandCombos; combo += 37) {
+        EXPECT_EQ(combo_of(combo_name(combo)), combo);
+    }
+}
+
+TEST(RangeNotationTest, RejectsMalformedItems) {
+    for (const char* bad : {"AKx", "A", "AKs-QJs", "AA-AKs", "AZ", "AhAh", "AK:", "AK:-1",
+                            "AK:x", "AKs++", "TT+:0.5x"}) {
+        EXPECT_THROW(parse_range_notation(bad), std::invalid_argument) << bad;
+    }
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+#include "../core/deck.h"
+#include "../engine/river_solver.h"
+#include "../evaluators/hand_types.h"
+#include "../evaluators/omp_eval.h"
+
+using namespace poker_engine;
+
+namespace {
+
+BoardRanks ranks_on(const OMPEval& evaluator, const std::array<uint8_t, 5>& board) {
+    BoardRanks ranks{};
+    uint8_t ids[7] = {0, 0, board[0], board[1], board[2], board[3], board[4]};
+    for (int combo = 0; combo < kNumHandCombos; ++combo) {
+        ids[0] = hand_index_tables::kComboCards[combo][0];
+        ids[1] = hand_index_tables::kComboCards[combo][1];
+        bool on_board = false;
+        for (uint8_t b : board) on_board |= (b == ids[0] || b == ids[1]);
+        if (!on_board) ranks[combo] = evaluator.evaluate(CardIds(ids, 7));
+    }
+    return ranks;
+}
+
+// Every matchup played out one by one
+ComboShowdown brute_force(const BoardRanks& ranks, const ComboWeights& weights, int hero) {
+    ComboShowdown result;
+    const auto& cards = hand_index_tables::kComboCards[hero];
+    for (int opp = 0; opp < kNumHandCombos; ++opp) {
+        if (ranks[opp] <= 0 || weights[opp] == 0) continue;
+        const auto& opp_cards = hand_index_tables::kComboCards[opp];
+        bool blocked = false;
+        for (uint8_t c : opp_cards) blocked |= (c == cards[0] || c == cards[1]);
+        if (blocked) continue;
+        const uint64_t w = weights[opp];
+        result.total += w;
+        const int opp_type = get_hand_type(ranks[opp]);
+        if (ranks[hero] > ranks[opp]) {
+            result.wins += w;
+            result.wins_by_opp_type[opp_type] += w;
+        } else if (ranks[hero] == ranks[opp]) {
+            result.ties += w;
+        } else {
+            result.losses += w;
+            result.losses_by_opp_type[opp_type] += w;
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(RiverSolverTest, MatchesBruteForceOnRandomBoards) {
+    OMPEval evaluator;
+    Deck deck(17);
+    for (int iter = 0; iter < 20; ++iter) {
+        deck.reset();
+        std::array<uint8_t, 5> board;
+        for (uint8_t& id : board) id = card_id(deck.sample(1)[0]);
+        const BoardRanks ranks = ranks_on(evaluator, board);
+
+        // Uniform on even boards, uneven weights (and some zeros) on odd ones
+        ComboWeights weights = RiverSolver::uniform_weights(ranks);
+        if (iter % 2) {
+            for (int combo = 0; combo < kNumHandCombos; ++combo) weights[combo] *= combo % 5;
+        }
+        const RiverSolver solver(ranks, weights);
+
+        for (int hero = 0; hero < kNumHandCombos; hero += 7) {
+            const ComboShowdown expected = brute_force(ranks, weights, hero);
+            const ComboShowdown actual = solver.solve(hero);
+            if (ranks[hero] <= 0) {
+                EXPECT_EQ(actual.total, 0u);
+                continue;
+            }
+            ASSERT_EQ(actual.wins, expected.wins) << iter << " " << hero;
+            ASSERT_EQ(actual.ties, expected.ties) << iter << " " << hero;
+            ASSERT_EQ(actual.losses, expected.losses) << iter << " " << hero;
+            ASSERT_EQ(actual.total, expected.total) << iter << " " << hero;
+            ASSERT_EQ(actual.wins_by_opp_type, expected.wins_by_opp_type) << iter << " " << hero;
+            ASSERT_EQ(actual.losses_by_opp_type, expected.losses_by_opp_type) << iter << " " << hero;
+        }
+    }
+}
+
+TEST(RiverSolverTest, UniformRangeCountsEveryOpenOpponentHand) {
+    OMPEval evaluator;
+    // 2c 7d 9h Js Ks: 47 cards left, 45 once the hero's are out
+    const std::array<uint8_t, 5> board = {0, 21, 30, 39, 47};
+    const BoardRanks ranks = ranks_on(evaluator, board);
+    const ComboWeights weights = RiverSolver::uniform_weights(ranks);
+    const RiverSolver solver(ranks, weights);
+
+    const ComboShowdown aces = solver.solve(hand_combo_index(48, 49));
+    EXPECT_EQ(aces.total, 45u * 44u / 2u);
+    EXPECT_EQ(aces.wins + aces.ties + aces.losses, aces.total);
+    EXPECT_EQ(solver.solve(hand_combo_index(0, 1)).total, 0u);  // holds a board card
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <vector>
+#include "../engine/runout_enumerator.h"
+
+using namespace poker_engine;
+
+namespace {
+
+constexpr uint64_t kFullDeck = (1ULL << 52) - 1;
+
+// Every card of the current deal, board first
+std::vector<uint8_t> current_deal(const RunoutEnumerator& deals, int board_cards,
+                                  int num_opponents) {
+    std::vector<uint8_t> cards;
+    for (int j = 0; j < board_cards; ++j) cards.push_back(deals.card(0, j));
+    for (int o = 0; o < num_opponents; ++o) {
+        cards.push_back(deals.card(o + 1, 0));
+        cards.push_back(deals.card(o + 1, 1));
+    }
+    return cards;
+}
+
+}  // namespace
+
+TEST(RunoutEnumeratorTest, CountsDeals) {
+    EXPECT_EQ(binomial(52, 5), 2598960u);
+    EXPECT_EQ(RunoutEnumerator::count(5, 1), 990u);
+    EXPECT_EQ(RunoutEnumerator::count(4, 1), 46u * 990u);
+    EXPECT_EQ(RunoutEnumerator::count(5, 2), 990u * 903u);
+    EXPECT_EQ(RunoutEnumerator::count(0, 0), binomial(50, 5));
+    EXPECT_EQ(RunoutEnumerator::count(0, 9), std::numeric_limits<uint64_t>::max());
+}
+
+TEST(RunoutEnumeratorTest, WalksEveryDealOnce) {
+    // Turn, one opponent: the hero's two cards and four board cards are dead
+    const uint64_t live = kFullDeck & ~0x3FULL;
+    RunoutEnumerator deals(live, 1, 1);
+
+    std::set<std::vector<uint8_t>> seen;
+    int changed = 0;
+    uint64_t n = 0;
+    do {
+        std::vector<uint8_t> cards = current_deal(deals, 1, 1);
+        std::set<uint8_t> distinct(cards.begin(), cards.end());
+        ASSERT_EQ(distinct.size(), 3u);
+        for (uint8_t id : cards) ASSERT_TRUE(live & (1ULL << id));
+        seen.insert(cards);
+        ++n;
+        changed = deals.next();
+    } while (changed >= 0);
+
+    EXPECT_EQ(n, RunoutEnumerator::count(4, 1));
+    EXPECT_EQ(seen.size(), n);
+}
+
+TEST(RunoutEnumeratorTest, NextReportsTheFirstChangedLevel) {
+    RunoutEnumerator deals(kFullDeck & ~0x7FULL, 0, 3);  // river, 3 opponents
+    std::vector<uint8_t> before = current_deal(deals, 0, 3);
+    for (int step = 0; step < 100000; ++step) {
+        const int changed = deals.next();
+        ASSERT_GE(changed, 1);
+        std::vector<uint8_t> after = current_deal(deals, 0, 3);
+        // Levels before the changed one keep their cards
+        for (int i = 0; i < 2 * (changed - 1); ++i) ASSERT_EQ(before[i], after[i]);
+        ASSERT_NE(before, after);
+        before = after;
+    }
+}
+
+TEST(RunoutEnumeratorTest, SeekMatchesStepping) {
+    // Flop, two opponents
+    const uint64_t live = kFullDeck & ~0x1FULL;
+    RunoutEnumerator stepped(live, 2, 2);
+    RunoutEnumerator seeked(live, 2, 2);
+    for (uint64_t index = 0; index < 50000; ++index) {
+        if (index % 997 == 0) {
+            seeked.seek(index);
+            ASSERT_EQ(current_deal(stepped, 2, 2), current_deal(seeked, 2, 2)) << index;
+        }
+        stepped.next();
+    }
+}
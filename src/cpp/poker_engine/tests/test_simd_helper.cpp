@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../engine/simd_helper.h"
 #include <cstdint>
+#include <cstdlib>
+#include <iostream>
 
 namespace poker_engine {
 
@@ -29,15 +31,28 @@ TEST(SIMDHelperTest, AlignedAlloc) {
 }
 
 TEST(SIMDHelperTest, ArchitectureDetection) {
+  SimdLevel level = SIMDHelper::DetectLevel();
 #if defined(__aarch64__) || defined(__arm64__)
+  EXPECT_EQ(level, SimdLevel::kScalar);
   EXPECT_FALSE(SIMDHelper::IsAvx2Supported());
   std::cout << "[ INFO ] Running on ARM64 - SIMD paths disabled as expected." << std::endl;
-#elif defined(USE_AVX2)
-  EXPECT_TRUE(SIMDHelper::IsAvx2Supported());
-  std::cout << "[ INFO ] AVX2 Support detected and enabled." << std::endl;
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  if (std::getenv("POKER_ENGINE_SIMD") == nullptr) {
+    EXPECT_EQ(SIMDHelper::IsAvx2Supported(), __builtin_cpu_supports("avx2") != 0);
+    EXPECT_EQ(SIMDHelper::IsAvx512Supported(), __builtin_cpu_supports("avx512f") != 0);
+  }
+  std::cout << "[ INFO ] Runtime SIMD level: " << SIMDHelper::LevelName(level) << std::endl;
 #else
   std::cout << "[ INFO ] No SIMD architecture detected or enabled." << std::endl;
 #endif
 }
 
+TEST(SIMDHelperTest, BatchSizeFollowsLevel) {
+  EXPECT_EQ(SIMDHelper::BatchSize(SimdLevel::kScalar), 8);
+  EXPECT_EQ(SIMDHelper::BatchSize(SimdLevel::kSse4), 8);
+  EXPECT_EQ(SIMDHelper::BatchSize(SimdLevel::kAvx2), 8);
+  EXPECT_EQ(SIMDHelper::BatchSize(SimdLevel::kAvx512), 16);
+  EXPECT_LE(SIMDHelper::BatchSize(), SIMDConfig::kMaxBatchSize);
+}
+
 } // namespace poker_engine
\ No newline at end of file
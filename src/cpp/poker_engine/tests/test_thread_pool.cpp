@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "../engine/thread_pool.h"
+
+using namespace poker_engine;
+
+TEST(ThreadPoolTest, RunsEveryTask) {
+    ThreadPool pool(4);
+    std::atomic<int> sum{0};
+    {
+        TaskGroup group(pool);
+        for (int i = 1; i <= 1000; ++i) {
+            group.run([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    EXPECT_EQ(sum.load(), 500500);
+
+    const ThreadPool::Stats stats = pool.stats();
+    EXPECT_EQ(stats.threads, 4u);
+    EXPECT_EQ(stats.queued, 0u);
+    EXPECT_EQ(stats.tasks_completed, 1000u);
+    EXPECT_LE(stats.tasks_stolen, stats.tasks_completed);
+}
+
+TEST(ThreadPoolTest, WaitRethrowsTaskException) {
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 10; ++i) {
+        group.run([&ran, i] {
+            ran++;
+            if (i == 3) throw std::runtime_error("task failed");
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    // The other tasks still ran, and the error is only reported once
+    EXPECT_EQ(ran.load(), 10);
+    EXPECT_NO_THROW(group.wait());
+}
+
+TEST(ThreadPoolTest, NestedWaitOnSingleThreadDoesNotDeadlock) {
+    // The outer task holds the only thread, so it must run its own subtasks
+    ThreadPool pool(1);
+    std::atomic<int> inner{0};
+    TaskGroup outer(pool);
+    outer.run([&pool, &inner] {
+        EXPECT_TRUE(pool.owns_current_thread());
+        TaskGroup group(pool);
+        for (int i = 0; i < 100; ++i) group.run([&inner] { inner++; });
+        group.wait();
+    });
+    outer.wait();
+    EXPECT_EQ(inner.load(), 100);
+    EXPECT_FALSE(pool.owns_current_thread());
+    EXPECT_EQ(ThreadPool::current_worker(), -1);
+}
+
+TEST(ThreadPoolTest, IdleThreadsStealQueuedTasks) {
+    // Everything is queued on the thread running the outer task, which then
+    // blocks; only stealing lets the other thread finish the subtasks
+    ThreadPool pool(2);
+    std::atomic<int> inner{0};
+    TaskGroup outer(pool);
+    outer.run([&pool, &inner] {
+        TaskGroup group(pool);
+        for (int i = 0; i < 50; ++i) group.run([&inner] { inner++; });
+        while (inner.load() < 50) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        group.wait();
+    });
+    outer.wait();
+    EXPECT_EQ(inner.load(), 50);
+    EXPECT_GE(pool.stats().tasks_stolen, 50u);
+}
+
+TEST(ThreadPoolTest, WaitOnlyHelpsWithItsOwnGroup) {
+    // The unrelated task is the newest on the waiting thread's deque, but
+    // the wait must leave it for the pool instead of running it nested
+    ThreadPool pool(1);
+    std::atomic<int> order{0};
+    int inner_ran = -1;
+    int other_ran = -1;
+    TaskGroup outer(pool);
+    TaskGroup other(pool);
+    outer.run([&] {
+        TaskGroup group(pool);
+        group.run([&] { inner_ran = order++; });
+        other.run([&] { other_ran = order++; });
+        group.wait();
+        EXPECT_EQ(other_ran, -1);
+    });
+    outer.wait();
+    other.wait();
+    EXPECT_EQ(inner_ran, 0);
+    EXPECT_EQ(other_ran, 1);
+}
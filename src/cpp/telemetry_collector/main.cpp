@@ -91,7 +91,8 @@ int main(int argc, char* argv[]) {
                         equity_snapshot.results[i].losses,
                         equity_snapshot.results[i].simulations,
                         &win_matrix_flat,
-                        &loss_matrix_flat
+                        &loss_matrix_flat,
+                        equity_snapshot.results[i].std_error
                     );
                     equity_results_vec.push_back(hand_equity);
                 }
@@ -111,7 +112,12 @@ int main(int argc, char* argv[]) {
                     metrics.thread_count,
                     metrics.cpu_cycles,
                     telemetry_snapshot.status,
-                    equity_results_fb
+                    equity_results_fb,
+                    telemetry_snapshot.pool_threads,
+                    telemetry_snapshot.pool_utilization,
+                    telemetry_snapshot.pool_queued_tasks,
+                    telemetry_snapshot.pool_tasks_completed,
+                    telemetry_snapshot.pool_tasks_stolen
                 );
 
                 builder.Finish(packet);
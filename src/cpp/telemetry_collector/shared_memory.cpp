@@ -57,6 +57,11 @@ TelemetrySnapshot SharedMemoryReader::read_telemetry_consistent() const {
         snapshot.hands_processed = data->telemetry.hands_processed;
         snapshot.last_update_ns = data->telemetry.last_update_ns;
         snapshot.status = data->telemetry.status;
+        snapshot.pool_threads = data->telemetry.pool_threads;
+        snapshot.pool_utilization = data->telemetry.pool_utilization;
+        snapshot.pool_queued_tasks = data->telemetry.pool_queued_tasks;
+        snapshot.pool_tasks_completed = data->telemetry.pool_tasks_completed;
+        snapshot.pool_tasks_stolen = data->telemetry.pool_tasks_stolen;
 
         seq2 = data->telemetry.seq.load(std::memory_order_acquire);
 
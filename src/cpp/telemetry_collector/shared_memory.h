@@ -1,6 +1,7 @@
 #ifndef SHARED_MEMORY_H
 #define SHARED_MEMORY_H
 
+#include <cstddef>
 #include <cstdint>
 #include <atomic>
 #include <string>
@@ -18,7 +19,8 @@ struct HandEquityResult {
     uint32_t simulations; // Total simulations for this hand
     uint32_t win_method_matrix[10][10];   // Win frequency by hand type: [our_type][opp_type]
     uint32_t loss_method_matrix[10][10];  // Loss frequency by hand type: [opp_type][our_type]
-    uint32_t _padding[2]; // Padding to make total 832 bytes (8 + 4 + 4 + 4 + 4 + 400 + 400 + 8 = 832)
+    float std_error;      // Standard error of equity (0 when every deal was enumerated)
+    uint32_t _padding;    // Padding to make total 832 bytes (8 + 4 + 4 + 4 + 4 + 400 + 400 + 4 + 4 = 832)
 };
 
 static_assert(sizeof(HandEquityResult) == 832, "HandEquityResult must be 832 bytes");
@@ -53,13 +55,20 @@ struct alignas(64) TelemetrySharedMemory {
     // Status flags (0 = running, 1 = completed, 2 = failed)
     uint8_t status;
 
-    // Reserved for future use (padding to cache line size)
-    uint8_t _reserved[31];
+    uint8_t _padding2[3];  // Align the pool fields
+
+    // Engine worker pool (all 0 if the writer does not report them)
+    uint32_t pool_threads;           // Threads in the pool
+    float pool_utilization;          // Busy fraction since the previous update (0.0 to 1.0)
+    uint32_t pool_queued_tasks;      // Tasks waiting to run
+    uint64_t pool_tasks_completed;   // Lifetime tasks run
+    uint64_t pool_tasks_stolen;      // Lifetime tasks run by a thread that stole them
 };
 
 // Size must be exactly one cache line (64 bytes) for cache coherency
 static_assert(sizeof(TelemetrySharedMemory) == 64, "Shared memory struct must be 64 bytes");
 static_assert(alignof(TelemetrySharedMemory) == 64, "Shared memory must be 64-byte aligned");
+static_assert(offsetof(TelemetrySharedMemory, pool_threads) == 36, "Pool fields follow status");
 
 // Complete shared memory layout
 struct CompleteSharedMemory {
@@ -72,6 +81,11 @@ struct TelemetrySnapshot {
     uint64_t hands_processed;
     uint64_t last_update_ns;
     uint8_t status;
+    uint32_t pool_threads;
+    float pool_utilization;
+    uint32_t pool_queued_tasks;
+    uint64_t pool_tasks_completed;
+    uint64_t pool_tasks_stolen;
 };
 
 struct EquityResultsSnapshot {
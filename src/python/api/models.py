@@ -27,6 +27,9 @@ class OptimizationType(str, Enum):
     SIMD = "simd"
     PERFECT_HASH = "perfect_hash"
     PREFETCHING = "prefetching"
+    EXHAUSTIVE = "exhaustive"
+    BOARD_MAJOR = "board_major"
+    BOARD_CACHE = "board_cache"
 
 
 class CardModel(BaseModel):
@@ -2,7 +2,7 @@ import ctypes
 import mmap
 import os
 import time
-from ctypes import Structure, c_uint8, c_uint32, c_uint64, c_double, c_char
+from ctypes import Structure, c_uint8, c_uint32, c_uint64, c_double, c_char, c_float
 from typing import Optional, Dict
 
 # Maximum number of poker hands (13x13 matrix)
@@ -18,7 +18,8 @@ class HandEquityResult(Structure):
         ("simulations", c_uint32),               # 4 bytes
         ("win_method_matrix", (c_uint32 * 10) * 10),  # 400 bytes (10x10 matrix)
         ("loss_method_matrix", (c_uint32 * 10) * 10),  # 400 bytes (10x10 matrix)
-        ("_padding", c_uint32 * 2),              # 8 bytes (total 832 bytes)
+        ("std_error", c_float),                  # 4 bytes (0 when exact)
+        ("_padding", c_uint32),                  # 4 bytes (total 832 bytes)
     ]
 
 
@@ -39,7 +40,12 @@ class TelemetrySharedMemory(Structure):
         ("hands_processed", c_uint64),
         ("last_update_ns", c_uint64),
         ("status", c_uint8),
-        ("_reserved", c_uint8 * 31),
+        ("_padding2", c_uint8 * 3),
+        ("pool_threads", c_uint32),
+        ("pool_utilization", c_float),
+        ("pool_queued_tasks", c_uint32),
+        ("pool_tasks_completed", c_uint64),
+        ("pool_tasks_stolen", c_uint64),
     ]
 
 
@@ -2,6 +2,7 @@ import { EngineMode, HandRange, JobStatus, Card, AlgorithmType, OptimizationType
 
 export interface CreateJobRequest {
   range_spec: HandRange;
+  range?: string; // Optional, C++: range notation ("TT+, AKs, KQo:0.5"), one hand per combo
   board?: Card[];
   num_opponents: number; // 1-9
   num_simulations: number; // 1000-10000000
@@ -13,11 +14,21 @@ export interface CreateJobRequest {
   algorithm?: AlgorithmType; // Core algorithm to use
   optimizations?: OptimizationType[]; // Optional optimizations to apply
   num_workers?: number; // Optional, for multithreading optimization
+  seed?: number; // Optional, makes a C++ job reproducible
+  target_std_error?: number; // Optional, C++ precision mode: sample each hand until its standard error is at most this
+  target_ci_half_width?: number; // Optional, the same as a 95% interval half-width (1.96 standard errors)
+  schedule?: "uniform" | "neyman" | "progressive"; // Optional, C++: how num_simulations is split across hands
+  opponent_ranges?: (WeightedCombo[] | string)[]; // Optional, C++: each seat's weighted range or range notation (one for all seats, or one per seat)
 
   // Legacy mode field (deprecated, but kept for backwards compatibility)
   mode?: EngineMode;
 }
 
+export interface WeightedCombo {
+  cards: [Card, Card];
+  weight?: number; // Default 1; any non-negative scale
+}
+
 export interface CreateJobResponse {
   job_id: string;
   status: JobStatus;
@@ -41,6 +52,7 @@ export interface EquityResult {
   ties: number;
   losses: number;
   total_simulations: number;
+  std_error?: number; // Standard error of equity (0 when exact)
 }
 
 export interface PerformanceMetrics {
@@ -57,6 +69,9 @@ export interface PerformanceMetrics {
   memory_mb?: number;
   num_workers?: number;
   cpu_cycles?: number; // From perf_event_open hardware counter
+  pool_threads?: number; // C++ engine worker pool size
+  pool_utilization?: number; // 0.0 to 1.0, busy fraction since the previous update
+  pool_tasks_stolen?: number; // Lifetime (hand, chunk) tasks run by a stealing thread
   cache_misses?: number; // Future: from perf counters
   branch_misses?: number; // Future: from perf counters
 }
@@ -67,6 +82,7 @@ export interface TelemetryUpdate {
   progress: number; // 0.0 to 1.0
   current_results: Record<string, number>; // hand_name -> equity
   sample_counts: Record<string, number>; // hand_name -> simulation count
+  std_errors?: Record<string, number>; // hand_name -> standard error of equity (C++ engine)
   win_method_matrices: Record<string, number[][]>; // hand_name -> 10x10 matrix [our_type][opp_type]
   loss_method_matrices: Record<string, number[][]>; // hand_name -> 10x10 matrix [opp_type][our_type]
   metrics: PerformanceMetrics;
@@ -165,6 +165,8 @@ export class MockAPIClient {
       cpp_base: 5.0,
       cpp_simd: 15.0,
       cpp_threaded: 8.0,
+      cpp_river_grid: 50.0,
+      cpp_preflop_matrix: 40.0,
     };
 
     return {
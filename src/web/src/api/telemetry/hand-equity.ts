@@ -84,8 +84,13 @@ lossMethodMatrixArray():Uint32Array|null {
   return offset ? new Uint32Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
 }
 
+stdError():number {
+  const offset = this.bb!.__offset(this.bb_pos, 20);
+  return offset ? this.bb!.readFloat32(this.bb_pos + offset) : 0.0;
+}
+
 static startHandEquity(builder:flatbuffers.Builder) {
-  builder.startObject(8);
+  builder.startObject(9);
 }
 
 static addHandName(builder:flatbuffers.Builder, handNameOffset:flatbuffers.Offset) {
@@ -154,12 +159,16 @@ static startLossMethodMatrixVector(builder:flatbuffers.Builder, numElems:number)
   builder.startVector(4, numElems, 4);
 }
 
+static addStdError(builder:flatbuffers.Builder, stdError:number) {
+  builder.addFieldFloat32(8, stdError, 0.0);
+}
+
 static endHandEquity(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
 }
 
-static createHandEquity(builder:flatbuffers.Builder, handNameOffset:flatbuffers.Offset, equity:number, wins:number, ties:number, losses:number, simulations:number, winMethodMatrixOffset:flatbuffers.Offset, lossMethodMatrixOffset:flatbuffers.Offset):flatbuffers.Offset {
+static createHandEquity(builder:flatbuffers.Builder, handNameOffset:flatbuffers.Offset, equity:number, wins:number, ties:number, losses:number, simulations:number, winMethodMatrixOffset:flatbuffers.Offset, lossMethodMatrixOffset:flatbuffers.Offset, stdError:number):flatbuffers.Offset {
   HandEquity.startHandEquity(builder);
   HandEquity.addHandName(builder, handNameOffset);
   HandEquity.addEquity(builder, equity);
@@ -169,6 +178,7 @@ static createHandEquity(builder:flatbuffers.Builder, handNameOffset:flatbuffers.
   HandEquity.addSimulations(builder, simulations);
   HandEquity.addWinMethodMatrix(builder, winMethodMatrixOffset);
   HandEquity.addLossMethodMatrix(builder, lossMethodMatrixOffset);
+  HandEquity.addStdError(builder, stdError);
   return HandEquity.endHandEquity(builder);
 }
 }
@@ -80,8 +80,33 @@ equityResultsLength():number {
   return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
 }
 
+poolThreads():number {
+  const offset = this.bb!.__offset(this.bb_pos, 24);
+  return offset ? this.bb!.readUint32(this.bb_pos + offset) : 0;
+}
+
+poolUtilization():number {
+  const offset = this.bb!.__offset(this.bb_pos, 26);
+  return offset ? this.bb!.readFloat32(this.bb_pos + offset) : 0.0;
+}
+
+poolQueuedTasks():number {
+  const offset = this.bb!.__offset(this.bb_pos, 28);
+  return offset ? this.bb!.readUint32(this.bb_pos + offset) : 0;
+}
+
+poolTasksCompleted():bigint {
+  const offset = this.bb!.__offset(this.bb_pos, 30);
+  return offset ? this.bb!.readUint64(this.bb_pos + offset) : BigInt('0');
+}
+
+poolTasksStolen():bigint {
+  const offset = this.bb!.__offset(this.bb_pos, 32);
+  return offset ? this.bb!.readUint64(this.bb_pos + offset) : BigInt('0');
+}
+
 static startTelemetryPacket(builder:flatbuffers.Builder) {
-  builder.startObject(10);
+  builder.startObject(15);
 }
 
 static addTimestampNs(builder:flatbuffers.Builder, timestampNs:bigint) {
@@ -136,6 +161,26 @@ static startEquityResultsVector(builder:flatbuffers.Builder, numElems:number) {
   builder.startVector(4, numElems, 4);
 }
 
+static addPoolThreads(builder:flatbuffers.Builder, poolThreads:number) {
+  builder.addFieldInt32(10, poolThreads, 0);
+}
+
+static addPoolUtilization(builder:flatbuffers.Builder, poolUtilization:number) {
+  builder.addFieldFloat32(11, poolUtilization, 0.0);
+}
+
+static addPoolQueuedTasks(builder:flatbuffers.Builder, poolQueuedTasks:number) {
+  builder.addFieldInt32(12, poolQueuedTasks, 0);
+}
+
+static addPoolTasksCompleted(builder:flatbuffers.Builder, poolTasksCompleted:bigint) {
+  builder.addFieldInt64(13, poolTasksCompleted, BigInt('0'));
+}
+
+static addPoolTasksStolen(builder:flatbuffers.Builder, poolTasksStolen:bigint) {
+  builder.addFieldInt64(14, poolTasksStolen, BigInt('0'));
+}
+
 static endTelemetryPacket(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
@@ -149,7 +194,7 @@ static finishSizePrefixedTelemetryPacketBuffer(builder:flatbuffers.Builder, offs
   builder.finish(offset, undefined, true);
 }
 
-static createTelemetryPacket(builder:flatbuffers.Builder, timestampNs:bigint, jobStartNs:bigint, handsProcessed:bigint, cpuPercent:number, memoryRssKb:bigint, memoryVmsKb:bigint, threadCount:number, cpuCycles:bigint, status:number, equityResultsOffset:flatbuffers.Offset):flatbuffers.Offset {
+static createTelemetryPacket(builder:flatbuffers.Builder, timestampNs:bigint, jobStartNs:bigint, handsProcessed:bigint, cpuPercent:number, memoryRssKb:bigint, memoryVmsKb:bigint, threadCount:number, cpuCycles:bigint, status:number, equityResultsOffset:flatbuffers.Offset, poolThreads:number, poolUtilization:number, poolQueuedTasks:number, poolTasksCompleted:bigint, poolTasksStolen:bigint):flatbuffers.Offset {
   TelemetryPacket.startTelemetryPacket(builder);
   TelemetryPacket.addTimestampNs(builder, timestampNs);
   TelemetryPacket.addJobStartNs(builder, jobStartNs);
@@ -161,6 +206,11 @@ static createTelemetryPacket(builder:flatbuffers.Builder, timestampNs:bigint, jo
   TelemetryPacket.addCpuCycles(builder, cpuCycles);
   TelemetryPacket.addStatus(builder, status);
   TelemetryPacket.addEquityResults(builder, equityResultsOffset);
+  TelemetryPacket.addPoolThreads(builder, poolThreads);
+  TelemetryPacket.addPoolUtilization(builder, poolUtilization);
+  TelemetryPacket.addPoolQueuedTasks(builder, poolQueuedTasks);
+  TelemetryPacket.addPoolTasksCompleted(builder, poolTasksCompleted);
+  TelemetryPacket.addPoolTasksStolen(builder, poolTasksStolen);
   return TelemetryPacket.endTelemetryPacket(builder);
 }
 }
@@ -25,7 +25,7 @@ export const ModeSelector: React.FC<ModeSelectorProps> = ({
   disabled = false,
 }) => {
   const pythonModes: EngineMode[] = ["base_python", "senzee", "numpy", "multiprocessing"];
-  const cppModes: EngineMode[] = ["cpp_naive", "cpp_base", "cpp_simd", "cpp_threaded"];
+  const cppModes: EngineMode[] = ["cpp_naive", "cpp_base", "cpp_simd", "cpp_threaded", "cpp_river_grid", "cpp_preflop_matrix"];
 
   const formatModeName = (m: string): string => {
     // Special cases for display names
@@ -46,6 +46,12 @@ export const ModeSelector: React.FC<ModeSelectorProps> = ({
     if (m === "cpp_naive") {
       return "C++ port of the naive brute-force evaluator";
     }
+    if (m === "cpp_river_grid") {
+      return "Exact heads-up equity of the whole 13x13 grid on a complete board, solved from sorted hand strengths";
+    }
+    if (m === "cpp_preflop_matrix") {
+      return "Heads-up preflop equity of every hand class against every other, from boards shared by all matchups";
+    }
     return null;
   };
 
@@ -57,6 +57,27 @@ const OPTIMIZATIONS: OptimizationInfo[] = [
       "CPU cache prefetch hints to reduce memory latency. Most effective with large lookup tables like Two Plus Two.",
     estimatedGain: "10-30%",
   },
+  {
+    id: "exhaustive",
+    name: "Exhaustive Enumeration",
+    description:
+      "Evaluates every remaining runout and opponent hand instead of sampling, for exact equities. Used automatically when there are fewer runouts than simulations (e.g. turn or river vs one opponent).",
+    estimatedGain: "Exact",
+  },
+  {
+    id: "board_major",
+    name: "Board-Major Sampling",
+    description:
+      "Deals each board and opponent set once and scores every hand in the range against it, so the range shares its runouts. Fastest on large ranges; hands are compared on the same boards.",
+    estimatedGain: "2-4x on large ranges",
+  },
+  {
+    id: "board_cache",
+    name: "Board Rank Cache",
+    description:
+      "Ranks all 1326 hole-card combos once per board and caches them across jobs, so showdowns on a known flop, turn or river become table lookups. Repeated jobs on the same board skip evaluation almost entirely.",
+    estimatedGain: "1.5-2x on flops and later",
+  },
 ];
 
 // Compatibility matrix: which optimizations work with which algorithms
@@ -64,11 +85,11 @@ const OPTIMIZATION_COMPATIBILITY: Record<
   AlgorithmType,
   OptimizationType[]
 > = {
-  naive: ["multithreading"],
-  cactus_kev: ["multithreading", "perfect_hash", "prefetching"],
-  ph_evaluator: ["multithreading", "perfect_hash"],
-  two_plus_two: ["multithreading", "prefetching"],
-  omp_eval: ["multithreading", "simd"],
+  naive: ["multithreading", "exhaustive", "board_major", "board_cache"],
+  cactus_kev: ["multithreading", "perfect_hash", "prefetching", "exhaustive", "board_major", "board_cache"],
+  ph_evaluator: ["multithreading", "perfect_hash", "exhaustive", "board_major", "board_cache"],
+  two_plus_two: ["multithreading", "prefetching", "exhaustive", "board_major", "board_cache"],
+  omp_eval: ["multithreading", "simd", "exhaustive", "board_major", "board_cache"],
 };
 
 // Mutual exclusivity: SIMD and PERFECT_HASH cannot be used together
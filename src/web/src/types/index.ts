@@ -11,7 +11,10 @@ export type OptimizationType =
   | "multithreading"
   | "simd"
   | "perfect_hash"
-  | "prefetching";
+  | "prefetching"
+  | "exhaustive"
+  | "board_major"
+  | "board_cache";
 
 // Implementation type for routing requests
 export type ImplementationType = "python" | "cpp";
@@ -25,7 +28,9 @@ export type EngineMode =
   | "cpp_naive"
   | "cpp_base"
   | "cpp_simd"
-  | "cpp_threaded";
+  | "cpp_threaded"
+  | "cpp_river_grid"
+  | "cpp_preflop_matrix";
 
 export interface Card {
   rank: number; // 2-14 (2-10, J=11, Q=12, K=13, A=14)
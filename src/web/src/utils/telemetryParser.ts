@@ -16,6 +16,9 @@ interface BinaryTelemetryData {
   thread_count: number;
   cpu_cycles: bigint;
   status: number;
+  pool_threads: number;
+  pool_utilization: number;
+  pool_tasks_stolen: bigint;
 }
 
 export function parseTelemetryPacket(
@@ -40,6 +43,9 @@ export function parseTelemetryPacket(
       thread_count: packet.threadCount(),
       cpu_cycles: packet.cpuCycles(),
       status: packet.status(),
+      pool_threads: packet.poolThreads(),
+      pool_utilization: packet.poolUtilization(),
+      pool_tasks_stolen: packet.poolTasksStolen(),
     };
 
     // Helper function to convert specific hands (e.g., "AsKh") to general types (e.g., "AKs")
@@ -75,6 +81,7 @@ export function parseTelemetryPacket(
     // Extract equity results, sample counts, and win-method matrices
     const currentResults: Record<string, number> = {};
     const sampleCounts: Record<string, number> = {};
+    const stdErrors: Record<string, number> = {};
     const winMethodMatrices: Record<string, number[][]> = {};
     const lossMethodMatrices: Record<string, number[][]> = {};
     const equityResultsLength = packet.equityResultsLength();
@@ -88,6 +95,7 @@ export function parseTelemetryPacket(
           const normalizedHandName = normalizeHandName(originalHandName);
           currentResults[normalizedHandName] = handEquity.equity();
           sampleCounts[normalizedHandName] = handEquity.simulations();
+          stdErrors[normalizedHandName] = handEquity.stdError();
 
           // Parse win-method matrix (flattened 100-element array)
           if (typeof handEquity.winMethodMatrixArray === 'function') {
@@ -151,6 +159,9 @@ export function parseTelemetryPacket(
       memory_mb: Number(data.memory_rss_kb) / 1024,
       num_workers: data.thread_count > 1 ? data.thread_count : undefined,
       cpu_cycles: data.cpu_cycles > BigInt(0) ? Number(data.cpu_cycles) : undefined,
+      pool_threads: data.pool_threads > 0 ? data.pool_threads : undefined,
+      pool_utilization: data.pool_threads > 0 ? data.pool_utilization : undefined,
+      pool_tasks_stolen: data.pool_threads > 0 ? Number(data.pool_tasks_stolen) : undefined,
     };
 
     const telemetryUpdate: TelemetryUpdate = {
@@ -159,6 +170,7 @@ export function parseTelemetryPacket(
       progress: jobStatus === "completed" ? 1.0 : 0.0,
       current_results: currentResults,
       sample_counts: sampleCounts,
+      std_errors: stdErrors,
       win_method_matrices: winMethodMatrices,
       loss_method_matrices: lossMethodMatrices,
       metrics,
@@ -17,6 +17,22 @@ int maxHR = 0;
 int64 maxID = 0;
 int numcards = 0; 
 
+// Trailer checksum: a copy of hand_ranks_checksum in
+// src/cpp/poker_engine/evaluators/hand_ranks_table.h, which must match
+uint64_t hand_ranks_checksum(const int32_t* data, size_t entries) {
+    const uint64_t prime = 0x100000001B3ull;
+    uint64_t lanes[4] = {0xCBF29CE484222325ull, 0x84222325CBF29CE4ull, 0x9E3779B97F4A7C15ull,
+                         0xC2B2AE3D27D4EB4Full};
+    size_t i = 0;
+    for (; i + 4 <= entries; i += 4) {
+        for (int lane = 0; lane < 4; lane++) lanes[lane] = (lanes[lane] ^ (uint32_t)data[i + lane]) * prime;
+    }
+    for (; i < entries; i++) lanes[0] = (lanes[0] ^ (uint32_t)data[i]) * prime;
+    uint64_t hash = entries;
+    for (int lane = 0; lane < 4; lane++) hash = (hash ^ lanes[lane]) * prime;
+    return hash;
+}
+
 // Cactus Kev Primes
 const int primes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41 };
 
@@ -324,6 +340,18 @@ int main() {
     // Only write the actually used portion of the table (up to maxHR + 1)
     size_t bytes_to_write = (maxHR + 1) * sizeof(int);
     fwrite(HR, bytes_to_write, 1, fout);
+
+    // Trailer: magic, entry count and checksum, so the engine can reject a
+    // truncated or damaged copy (see HandRanksTrailer)
+    struct {
+        char magic[8];
+        uint64_t entries;
+        uint64_t checksum;
+    } trailer;
+    memcpy(trailer.magic, "HRANKS01", 8);
+    trailer.entries = maxHR + 1;
+    trailer.checksum = hand_ranks_checksum(HR, trailer.entries);
+    fwrite(&trailer, sizeof(trailer), 1, fout);
     fclose(fout);
 
     printf("HandRanks.dat generated (%zu MB).\n", bytes_to_write / (1024*1024));